@@ -6,6 +6,59 @@
  * @brief This Program generats random solutions for the 3-colorability problem. These solutions are 
  * generated automatically. If the solution is better than the current best stored in the circular
  * buffer provided by the supervisor then the solution is sent to the circular buffer and stored.
+ * The buffer is a lock-free ring (see ring.h), generators never wait for each other.
+ *
+ * The strategy is chosen with -s: "random" evaluates one random coloring per attempt, "sliced"
+ * evaluates SLICE_LANES random colorings per pass over the edges and keeps the best one and
+ * "minconf" runs a min-conflicts local search with tabu list and restarts and "anneal" runs
+ * simulated annealing (see search.c). "exact" runs a branch and bound search (see exact.c) whose
+ * subtrees are shared by the threads of all exact generators through the shared memory; the thread
+ * that finishes the last subtree tells the supervisor that its best solution is optimal. An exact
+ * generator ends once no subtree is left. The annealing schedule is set per generator with -T
+ * (start temperature, default 2), -a (cooling factor, default 0.95) and -L (moves per
+ * temperature, default 10 per vertex).
+ *
+ * With -t N one generator process runs N search threads. They share the graph, which is only
+ * read after it has been built, and the mapping of the shared memory. Every thread has its own
+ * struct worker with RNG and coloring state.
+ *
+ * All randomness comes from xoshiro256** (see rng.h). --seed N makes a run repeatable: thread i
+ * uses the stream of N jumped ahead i times. Without --seed the seed is taken from the clock and
+ * the process id, so generators started at the same time still search differently.
+ *
+ * minconf and anneal do not search the whole graph: vertices of degree below 3 are removed first
+ * and the remaining 3-core is cut into biconnected blocks (see reduce.h), which every thread
+ * searches one after another in time slices, see runBlocks(). --no-reduce searches the whole
+ * graph instead.
+ *
+ * minconf and anneal start most of their runs from a coloring of the supervisor's elite pool (see
+ * ring.h) with a few vertices recolored at random, see search_start(), so the generators build on
+ * each other's best colorings instead of searching independently.
+ *
+ * "evolve" uses the elite pool as the population of an evolutionary search (see evolve.c): the
+ * threads cross two colorings of the pool, improve the child with min-conflicts and send it back
+ * as an offspring, the supervisor selects which offspring stay in the pool. It searches the whole
+ * graph and needs a supervisor that has the graph and a pool of at least two colorings.
+ *
+ * "auto" leaves the choice to the supervisor: the threads play turns of PORTFOLIO_TURN_MS, each
+ * with one of sliced, minconf, anneal and evolve, picked by the shares the supervisor sets in the
+ * control block of the shared memory (see ring.h and runPortfolio()). The blocks of the reduced
+ * graph keep their colorings from one turn to the next.
+ *
+ * -J selects the job, the generator then works for the supervisor started with the same -J (see
+ * ring_name()).
+ *
+ * The generator stops as soon as the supervisor shuts down or the best solution has been proven
+ * optimal: both advance the cancellation epoch of the shared memory (see ring.h), which the search
+ * threads poll every few thousand operations, see search_cancelled(). SIGINT and SIGTERM stop the
+ * threads the same way; a generator that still runs STOP_GRACE_S seconds later is ended by SIGALRM.
+ * A generator whose supervisor was killed stops as well, the threads check for that about every
+ * ORPHAN_CHECK_S seconds, also while they wait for room on a full ring (see producerStopped()).
+ * Either way the generator detaches from the shared memory before it exits, the SIGALRM handler
+ * included; the supervisor waits for that before it removes the segment.
+ *
+ * Solutions are sent with the vertex numbers of the input, also if the graph was renumbered
+ * because its file numbered the vertices sparsely.
  *
  */
 
@@ -20,43 +73,141 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/types.h>
-#include <semaphore.h>
 #include <time.h>
+#include <signal.h>
+#include <pthread.h>
+#include <getopt.h>
+#include "graph.h"
+#include "coloring.h"
+#include "search.h"
+#include "ring.h"
+#include "reduce.h"
+
+
+/*A block is searched for BLOCK_SLICE_MS in the first round, twice as long in the next and so on,
+at most 2^BLOCK_SLICE_DOUBLINGS times as long.*/
+#define BLOCK_SLICE_MS 50
+#define BLOCK_SLICE_DOUBLINGS 8
+
+/*A run starts from an elite coloring with probability 1 - 1/ELITE_ODDS if the pool has one, and
+every vertex of it gets a random color with probability 1/ELITE_PERTURB.*/
+#define ELITE_ODDS 4
+#define ELITE_PERTURB 10
+
+/*Length of a turn of the portfolio.*/
+#define PORTFOLIO_TURN_MS 1000
+
+/*Seconds the search threads get to stop after SIGINT or SIGTERM.*/
+#define STOP_GRACE_S 1
+
+/*Seconds between two checks whether the supervisor is still running.*/
+#define ORPHAN_CHECK_S 1
+
+/*Milliseconds an exact search thread waits before it tries again to lease a subtree, while all
+subtrees left are leased by others.*/
+#define CLAIM_WAIT_MS 100
+
+/*State of a thread searching the blocks of the reduced graph. best holds the best coloring found
+for each block, conflicts its number of conflicting edges and total their sum. The search of block
+current ends at deadline if timed is set. round counts the rounds over all blocks.*/
+struct blockrun{
+	const struct graph *g;
+	unsigned char **best;
+	unsigned int *conflicts;
+	unsigned int total;
+	unsigned int current;
+	unsigned int round;
+	int timed;
+	struct timespec deadline;
+	unsigned char *color;
+};
 
-#define CIRC_BUF_LEN 40
-#define SEM_1 "/sem_1"
-#define SEM_2 "/sem_2"
-#define MTEX "/sem_3"
-#define SHM_NAME "/sharedspace"
-
-struct circ{
-	unsigned int edgeCount;
-	unsigned int write_pos;
-	unsigned int read_pos;
-	unsigned int termination;
-	char solutions[CIRC_BUF_LEN][100];
+/*State of the hooks of a search thread, w->hooks. run points to blocks while a block-wise search
+runs. A thread of the portfolio ends its turn at turnEnd, gain counts the edges its solutions took
+off the best solution during the turn. While leased is set, the thread searches the exact subtree
+subtree and renews its lease (see ring_renew_subtree()).*/
+struct hooks{
+	struct blockrun blocks;
+	struct blockrun *run;
+	int portfolio;
+	struct timespec turnEnd;
+	uint64_t gain;
+	int leased;
+	uint64_t subtree;
+	uint64_t lease;
 };
 
 struct circ *circ_buf;
-sem_t *free_sem;
-sem_t *used_sem;
-sem_t *mtex_sem;
+size_t circ_size;
+
+/*Name of the shared memory of the job.*/
+static char shmName[RING_NAME_MAX];
+
+/*The graph published by the supervisor, mapped read-only (NULL if there is none).*/
+void *graph_map;
+size_t graph_map_size;
 
 char *prog_name;
+
+/*The strategy all search threads run.*/
+static int (*strategy_fn)(struct worker *w);
+
+/*Set if this process has to stop its threads on its own, e.g. because not all could start or on
+a signal.*/
+static volatile sig_atomic_t local_stop;
+
+/*The cancellation epoch of the shared memory when the generator attached to it.*/
+static uint32_t epoch;
+
+/*Descriptor of the shared memory, kept open to check the lock of the supervisor (ring_orphaned()),
+and the second of the monotonic clock from which on the next check is due.*/
+static int shm_fd = -1;
+static long nextOrphanCheck;
+
+/*Set once the generator has detached from the shared memory (see detach()).*/
+static int detached;
+
+/*The blocks the search strategies work on, if reduced is set.*/
+static struct reduction reduction;
+static int reduced;
 static void usage();
 static void err_msg(char *msg);
-static int getMax(char *arguments[], int len);
+static double parseNumber(const char *str, double min, double max);
+static uint64_t parseSeed(const char *str);
 static void setup_shm();
-static void createSendSolution(int maxIdx, int edges[][maxIdx]);
-static void sendToSupervisor(char solution[], unsigned int edgeCount);
+static void *runWorker(void *arg);
+static int runBlocks(struct worker *w, int (*fn)(struct worker *w));
+static int initBlocks(struct worker *w, struct blockrun *run);
+static void freeBlocks(struct blockrun *run);
+static int runPortfolio(struct worker *w);
+static void reportBlocks(struct worker *w, struct blockrun *run);
+static int stopped();
+static int threadStopped(struct worker *w);
+static int supervisorGone(const struct timespec *now);
+static int producerStopped();
+static void detach();
+static int createSendSolution(struct worker *w);
+static int searchSliced(struct worker *w);
+static void publish(struct worker *w, const struct graph *g, const struct coloring *c,
+	unsigned int edgeCount);
+static void sendToSupervisor(const struct graph *g, const struct coloring *c,
+	unsigned int edgeCount);
 static void cleanup();
 static void exit_graceful();
+static void signal_handler(int signal);
+
+/*The strategies of the portfolio, by their index in the control block.*/
+static int (*const arms[RING_ARMS])(struct worker *w) = {
+	searchSliced, search_minconf, search_anneal, search_evolve
+};
 
 /**
  * Program entry point.
- * @brief The program starts here. There generators must be invoked with the edges as positional
- * arguments. From the edges, the number of vertices is calculated and the adjacency matrix that 
- * corresponds with the graph is created.
+ * @brief The program starts here. If the supervisor has published the graph, the generator needs
+ * no arguments and works directly on the read-only copy in shared memory. Otherwise the edges are
+ * given as positional arguments or with -f file (text or binary edge list, see graph.c) and the
+ * graph is built here: an edge array for the conflict checks and adjacency lists (see graph.h). If
+ * both exist, they must be the same graph.
  * 
  * @details Even though main creates the input set, the generator main-loop is stored in a different
  * function. 
@@ -67,46 +218,492 @@ static void exit_graceful();
 
 int main(int argc, char *argv[]){
 	prog_name = argv[0];
-	int len = argc-1;
-	srand(time(NULL));
-	if(argc < 2){
-		usage();
+
+	static const struct option longopts[] = {
+		{"seed", required_argument, NULL, 'S'},
+		{"no-reduce", no_argument, NULL, 'R'},
+		{NULL, 0, NULL, 0}
+	};
+	struct timespec now;
+	uint64_t seed;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+	seed = ((uint64_t)now.tv_sec << 32) ^ (uint64_t)now.tv_nsec ^ ((uint64_t)getpid() << 16);
+
+	char *strategy = "random";
+	const char *job = RING_JOB;
+	const char *file = NULL;
+	int reduce = 1;
+	unsigned int threads = 1;
+	struct worker schedule;
+	int c;
+
+	schedule.temp = 2.0;
+	schedule.cooling = 0.95;
+	schedule.steps = 0;
+
+	while((c = getopt_long(argc, argv, "s:T:a:L:t:f:J:", longopts, NULL)) != -1){
+		switch(c){
+			case 'S':
+				seed = parseSeed(optarg);
+				break;
+			case 'R':
+				reduce = 0;
+				break;
+			case 's':
+				strategy = optarg;
+				break;
+			case 'T':
+				schedule.temp = parseNumber(optarg, 1e-6, 1e6);
+				break;
+			case 'a':
+				schedule.cooling = parseNumber(optarg, 1e-6, 1.0);
+				break;
+			case 'L':
+				schedule.steps = parseNumber(optarg, 1.0, 1e12);
+				break;
+			case 't':
+				threads = parseNumber(optarg, 1.0, 1024.0);
+				break;
+			case 'f':
+				file = optarg;
+				break;
+			case 'J':
+				job = optarg;
+				break;
+			default:
+				usage();
+		}
+	}
+	if(ring_name(shmName, job) == -1){
+		err_msg("Job names are letters, digits, '_', '-' and '.', at most 64 of them.");
+	}
+	if(strcmp(strategy, "random") == 0){
+		strategy_fn = createSendSolution;
+	} else if(strcmp(strategy, "sliced") == 0){
+		strategy_fn = searchSliced;
+	} else if(strcmp(strategy, "minconf") == 0){
+		strategy_fn = search_minconf;
+		reduced = reduce;
+	} else if(strcmp(strategy, "anneal") == 0){
+		strategy_fn = search_anneal;
+		reduced = reduce;
+	} else if(strcmp(strategy, "exact") == 0){
+		strategy_fn = search_exact;
+	} else if(strcmp(strategy, "evolve") == 0){
+		strategy_fn = search_evolve;
+	} else if(strcmp(strategy, "auto") == 0){
+		strategy_fn = runPortfolio;
+		reduced = reduce;
+	} else {
+		err_msg("Unknown strategy, use random, sliced, minconf, anneal, exact, evolve or auto.");
 	}
 	
-	
-	/*Get Max and sanitize.*/
-	int max = getMax(argv+1,len);
-	
-	/*Indexes go from 0 to max*/
-	int graph[max+1][max+1];
+	struct graph graph;
+	const char *why;
+	int ownGraph = file != NULL || optind < argc;
+
+	if(file != NULL && optind < argc){
+		usage();
+	}
+
+	/*Parse and sanitize.*/
+	if(file != NULL && graph_from_file(&graph, file, &why) == -1){
+		err_msg((char *)why);
+	}
+	if(file == NULL && ownGraph && graph_from_args(&graph, argv+optind, argc-optind, &why) == -1){
+		err_msg((char *)why);
+	}
+
+	/*Create shared memory -> SHM needs to be created by supervisor before.*/
+	setup_shm();
 
-	/*set to zero */
-	for(int k = 0; k <= max; k++){
-		for(int l = 0; l <= max; l++){
-			graph[k][l] = 0;	
+	struct sigaction sa;
+
+	/*No SA_RESTART: a thread sleeping on the ring wakes up and checks for the stop.*/
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = signal_handler;
+	sigemptyset(&sa.sa_mask);
+	if(sigaction(SIGINT, &sa, NULL) == -1 || sigaction(SIGTERM, &sa, NULL) == -1 ||
+		sigaction(SIGALRM, &sa, NULL) == -1){
+		cleanup();
+		err_msg("Could not install the signal handlers.");
+	}
+
+	if(ownGraph && graph_map != NULL && graph_fingerprint(&graph) != circ_buf->graphHash){
+		graph_free(&graph);
+		cleanup();
+		err_msg("The graph differs from the one of the supervisor.");
+	}
+	if(!ownGraph){
+		if(graph_map == NULL){
+			cleanup();
+			usage();
+		}
+		graph_view(&graph, graph_map, circ_buf->graphN, circ_buf->graphM);
+	}
+	if(strategy_fn == search_evolve && circ_buf->eliteSlots < 2){
+		if(ownGraph){
+			graph_free(&graph);
+		}
+		cleanup();
+		err_msg("The evolve strategy needs a supervisor with the graph and at least 2 elites.");
+	}
+	if(reduced && reduce_init(&reduction, &graph, 1) == -1){
+		cleanup();
+		err_msg("Could not allocate any more memory!\n");
+	}
+
+	struct worker *workers = calloc(threads, sizeof(struct worker));
+	struct hooks *hooks = calloc(threads, sizeof(struct hooks));
+	pthread_t *tids = calloc(threads, sizeof(pthread_t));
+	unsigned int started = 0;
+	int failed = 0;
+
+	if(workers == NULL || hooks == NULL || tids == NULL){
+		cleanup();
+		err_msg("Could not allocate any more memory!\n");
+	}
+
+	struct rng stream;
+
+	rng_seed(&stream, seed);
+
+	/*Every thread gets the schedule, its own stream and coloring.*/
+	for(unsigned int i = 0; i < threads; i++){
+		workers[i] = schedule;
+		workers[i].g = &graph;
+		workers[i].rng = stream;
+		workers[i].hooks = &hooks[i];
+		hooks[i].portfolio = strategy_fn == runPortfolio;
+		rng_jump(&stream);
+		if(coloring_init(&workers[i].out, graph.n) == -1){
+			failed = 1;
+			break;
+		}
+		if(pthread_create(&tids[i], NULL, runWorker, &workers[i]) != 0){
+			coloring_free(&workers[i].out);
+			failed = 1;
+			break;
 		}
+		started++;
+	}
+	if(failed){
+		/*Let the threads that are already running stop.*/
+		local_stop = 1;
 	}
 
-	int i = 1;
-	int first,second;
+	for(unsigned int i = 0; i < started; i++){
+		void *ret;
 
-	/*Adjacency Matrix Set-Up*/
-	while(i <= len && argv[i] != NULL){
-		first = strtol(argv[i],NULL,10);
-		second = strtol(strchr(argv[i],'-')+1,NULL,10);
-		
-		if(errno == ERANGE){
-			err_msg("Under- or overflow ocured.\n");
+		pthread_join(tids[i], &ret);
+		if(ret != NULL){
+			failed = 1;
 		}
+		coloring_free(&workers[i].out);
+	}
+	free(workers);
+	free(hooks);
+	free(tids);
+	if(reduced){
+		reduce_free(&reduction);
+	}
+	if(ownGraph){
+		graph_free(&graph);
+	}
 
-		graph[first][second] = 1;
-		i++;		
+	if(failed){
+		cleanup();
+		err_msg("Could not start all search threads!\n");
 	}
+	exit_graceful();
+}
 
-	/*Create a set of edges for this input set.*/
-	createSendSolution(max,graph);
+/**
+ * Search thread.
+ * @brief Runs the strategy for one worker until the supervisor asks the generators to stop.
+ *
+ * @param arg the struct worker of the thread
+ *
+ * @return NULL on success, the worker if the strategy ran out of memory
+ */
 
-	exit(EXIT_SUCCESS);
+static void *runWorker(void *arg){
+	struct worker *w = arg;
+	int ret = reduced && strategy_fn != runPortfolio ? runBlocks(w, strategy_fn) : strategy_fn(w);
+
+	freeBlocks(&((struct hooks *)w->hooks)->blocks);
+	return ret == -1 ? w : NULL;
+}
+
+/**
+ * Portfolio of strategies.
+ * @brief Plays turns until the supervisor asks the generators to stop: picks a strategy by the
+ * shares of the control block, runs it for PORTFOLIO_TURN_MS (block-wise for minconf and anneal if
+ * the graph is reduced) and accounts the turn. evolve is replaced by minconf if the supervisor has
+ * no pool to breed from.
+ *
+ * @param w the worker
+ *
+ * @return 0 once the generator has to stop, -1 if there is not enough memory
+ */
+
+static int runPortfolio(struct worker *w){
+	struct hooks *h = w->hooks;
+
+	while(!stopped()){
+		unsigned int arm = ring_arm_pick(circ_buf, rng_unit(&w->rng));
+		struct timespec start;
+		struct timespec end;
+		int ret;
+
+		if(arm == RING_ARM_EVOLVE && circ_buf->eliteSlots < 2){
+			arm = RING_ARM_MINCONF;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		h->turnEnd = start;
+		h->turnEnd.tv_sec += PORTFOLIO_TURN_MS / 1000;
+		h->turnEnd.tv_nsec += PORTFOLIO_TURN_MS % 1000 * 1000000L;
+		if(h->turnEnd.tv_nsec >= 1000000000){
+			h->turnEnd.tv_sec++;
+			h->turnEnd.tv_nsec -= 1000000000;
+		}
+		h->gain = 0;
+
+		if(reduced && (arm == RING_ARM_MINCONF || arm == RING_ARM_ANNEAL)){
+			ret = runBlocks(w, arms[arm]);
+		} else {
+			ret = arms[arm](w);
+		}
+		if(ret == -1){
+			return -1;
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		ring_arm_account(circ_buf, arm, (end.tv_sec - start.tv_sec)*1000 +
+			(end.tv_nsec - start.tv_nsec)/1000000, h->gain);
+	}
+	return 0;
+}
+
+/**
+ * Set up the blocks.
+ * @brief Gives every block of the reduced graph a random coloring and sends the composed coloring
+ * if it beats the best of the supervisor.
+ *
+ * @param w the worker, w->g is the whole graph
+ * @param run the state to set up, zeroed
+ *
+ * @return 0 on success, -1 if there is not enough memory
+ */
+
+static int initBlocks(struct worker *w, struct blockrun *run){
+	run->g = w->g;
+	run->best = calloc(reduction.count+1, sizeof(unsigned char *));
+	run->conflicts = calloc(reduction.count+1, sizeof(unsigned int));
+	run->color = malloc(run->g->n > 0 ? run->g->n : 1);
+	if(run->best == NULL || run->conflicts == NULL || run->color == NULL){
+		return -1;
+	}
+
+	for(unsigned int b = 0; b < reduction.count; b++){
+		const struct graph *bg = &reduction.blocks[b].g;
+
+		run->best[b] = malloc(bg->n);
+		if(run->best[b] == NULL){
+			return -1;
+		}
+		for(unsigned int v = 0; v < bg->n; v++){
+			run->best[b][v] = rng_color(&w->rng);
+		}
+		for(unsigned int e = 0; e < bg->m; e++){
+			run->conflicts[b] += run->best[b][bg->eu[e]] == run->best[b][bg->ev[e]];
+		}
+		run->total += run->conflicts[b];
+	}
+	if(run->total < ring_best(circ_buf)){
+		reportBlocks(w, run);
+	}
+	return 0;
+}
+
+/**
+ * Free the blocks.
+ * @brief Also frees a state initBlocks() did not finish, or never started on.
+ */
+
+static void freeBlocks(struct blockrun *run){
+	if(run->best != NULL){
+		for(unsigned int b = 0; b < reduction.count; b++){
+			free(run->best[b]);
+		}
+	}
+	free(run->best);
+	free(run->conflicts);
+	free(run->color);
+	memset(run, 0, sizeof(*run));
+}
+
+/**
+ * Block-wise search.
+ * @brief Runs a strategy on every block of the reduced graph that still has conflicts, in
+ * rounds with growing time slices, until all blocks are conflict-free or the thread has to stop.
+ *
+ * @details The blocks start from random colorings (see initBlocks()) the first time, after that
+ * from where the last call left them. A block that is the only one left with conflicts is
+ * searched without a time limit. The hooks keep the best coloring of every block and send the
+ * composed coloring of the whole graph whenever the sum beats the best of the supervisor (see
+ * reportBlocks()).
+ *
+ * @param w the worker, w->g is the whole graph
+ * @param fn the strategy
+ *
+ * @return 0 once the thread has to stop, -1 if there is not enough memory
+ */
+
+static int runBlocks(struct worker *w, int (*fn)(struct worker *w)){
+	struct hooks *h = w->hooks;
+	struct blockrun *run = &h->blocks;
+	int ret = -1;
+
+	if(run->best == NULL && initBlocks(w, run) == -1){
+		freeBlocks(run);
+		return -1;
+	}
+
+	h->run = run;
+	for(; run->total > 0 && !threadStopped(w); run->round++){
+		unsigned int open = 0;
+		unsigned int shift = run->round < BLOCK_SLICE_DOUBLINGS ? run->round : BLOCK_SLICE_DOUBLINGS;
+		long slice = (long)BLOCK_SLICE_MS << shift;
+
+		for(unsigned int b = 0; b < reduction.count; b++){
+			open += run->conflicts[b] > 0;
+		}
+		for(unsigned int b = 0; b < reduction.count && !threadStopped(w); b++){
+			if(run->conflicts[b] == 0){
+				continue;
+			}
+			run->current = b;
+			run->timed = open > 1;
+			clock_gettime(CLOCK_MONOTONIC, &run->deadline);
+			run->deadline.tv_sec += slice / 1000;
+			run->deadline.tv_nsec += slice % 1000 * 1000000;
+			if(run->deadline.tv_nsec >= 1000000000){
+				run->deadline.tv_sec++;
+				run->deadline.tv_nsec -= 1000000000;
+			}
+
+			w->g = &reduction.blocks[b].g;
+			if(fn(w) == -1){
+				goto out;
+			}
+		}
+	}
+	ret = 0;
+
+out:
+	w->g = run->g;
+	h->run = NULL;
+	return ret;
+}
+
+/**
+ * Send the composed coloring.
+ * @brief Composes the best colorings of the blocks into one of the whole graph (see
+ * reduce_compose()) and publishes it, it has exactly run->total conflicting edges.
+ */
+
+static void reportBlocks(struct worker *w, struct blockrun *run){
+	reduce_compose(&reduction, run->best, run->color);
+	coloring_from_bytes(&w->out, run->color);
+	publish(w, run->g, &w->out, run->total);
+}
+
+/**
+ * Termination check.
+ * @brief Two loads, cheap enough for the innermost loops of the searches.
+ *
+ * @return 1 if the cancellation epoch moved on since the generator attached (the supervisor shuts
+ * down or the best solution is optimal) or this process stops its threads
+ */
+
+static int stopped(){
+	return ring_epoch(circ_buf) != epoch || local_stop;
+}
+
+/**
+ * Check for a killed supervisor.
+ * @brief About every ORPHAN_CHECK_S seconds one thread checks that the supervisor still runs. A
+ * supervisor that was killed cannot terminate the ring anymore, its generators stop on their own
+ * instead of searching on a segment nobody reads.
+ *
+ * @param now the time of CLOCK_MONOTONIC
+ *
+ * @return 1 if the supervisor is gone, local_stop is set then
+ */
+
+static int supervisorGone(const struct timespec *now){
+	long due = __atomic_load_n(&nextOrphanCheck, __ATOMIC_RELAXED);
+
+	if(now->tv_sec >= due && __atomic_compare_exchange_n(&nextOrphanCheck, &due,
+		now->tv_sec + ORPHAN_CHECK_S, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED) &&
+		ring_orphaned(circ_buf, shm_fd)){
+		local_stop = 1;
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * Termination check of a producer.
+ * @brief Passed to ring_reserve(), asked while a thread waits for room on a full ring.
+ *
+ * @return 1 if stopped() says so or the supervisor is gone
+ */
+
+static int producerStopped(){
+	struct timespec now;
+
+	if(stopped()){
+		return 1;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return supervisorGone(&now);
+}
+
+/**
+ * Termination check of a thread.
+ * @brief Also renews the lease of the exact subtree the thread searches.
+ *
+ * @return 1 if stopped() says so, the supervisor is gone (see supervisorGone()) or the thread
+ * plays a portfolio turn that is over
+ */
+
+static int threadStopped(struct worker *w){
+	struct hooks *h = w->hooks;
+	struct timespec now;
+
+	if(stopped()){
+		return 1;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if(supervisorGone(&now)){
+		return 1;
+	}
+
+	uint64_t ms = (uint64_t)now.tv_sec*1000 + now.tv_nsec/1000000;
+
+	if(h->leased && ms + RING_LEASE_MS/2 >= h->lease &&
+		ring_renew_subtree(circ_buf, h->subtree, &h->lease) == -1){
+		/*Somebody else took the subtree, the search goes on but does not renew it anymore.*/
+		h->leased = 0;
+	}
+	if(!h->portfolio){
+		return 0;
+	}
+	return now.tv_sec > h->turnEnd.tv_sec || (now.tv_sec == h->turnEnd.tv_sec &&
+		now.tv_nsec >= h->turnEnd.tv_nsec);
 }
 
 /**
@@ -118,123 +715,366 @@ int main(int argc, char *argv[]){
  * @details The solution is only sent to the supervisor if it is better than the current best. This 
  * saves space in the buffer and causes less computation to do for the supervisor. This is handled
  * via a shared variable called circ_buf->edgeCount. 
+ * Every attempt colors the vertices and walks the edge array once, so it costs O(|V| + |E|). The
+ * walk stops as soon as the attempt cannot beat the current best anymore. Colorings are bit-packed
+ * (see coloring.h), so the hot loop only counts; the conflicting edges are listed only for a
+ * solution that is going to be sent.
  * 
- * @param maxIdx number of vertices
- * @param edges	 the adjacency matrix 
+ * @param w the worker
  *
+ * @return 0 once the generator has to stop, -1 if there is not enough memory
  */
 
-static void createSendSolution(int maxIdx, int edges[][maxIdx+1]){
-
-	/*Create shared memory -> SHM needs to be created by supervisor before.*/
-	setup_shm();
+static int createSendSolution(struct worker *w){
+	const struct graph *g = w->g;
+	struct coloring vertex;
 
+	if(coloring_init(&vertex, g->n) == -1){
+		return -1;
+	}
 	
 	/*Generator Main Loop*/
 	while(1){
 	
-	if(circ_buf->termination == 1){
-		exit_graceful();
+	if(threadStopped(w)){
+		coloring_free(&vertex);
+		return 0;
 	}
 
+	coloring_random(&vertex, &w->rng);
+
+	unsigned int limit = ring_best(circ_buf);
+	unsigned int edgeCount = count_conflicts(g, &vertex, limit);
+
+	/*Legal Solution*/
+	if(edgeCount < limit){
+		publish(w, g, &vertex, edgeCount);
+	}
 
-	int workEdges[maxIdx+1][maxIdx+1];
+	}	
+}
 
-	for(int i = 0; i <= maxIdx; i++){
-		for(int j = 0; j <= maxIdx; j++){
-			workEdges[i][j] = edges[i][j];	
+/**
+ * Bit-sliced random search.
+ *
+ * @brief Like createSendSolution(), but SLICE_LANES random colorings are evaluated in one pass over
+ * the edges (see coloring.h). Only the best lane of a pass is a candidate for the supervisor.
+ *
+ * @param w the worker, its out coloring holds the best lane
+ *
+ * @return 0 once the generator has to stop, -1 if there is not enough memory
+ */
+
+static int searchSliced(struct worker *w){
+	const struct graph *g = w->g;
+	struct sliced batch;
+
+	if(sliced_init(&batch, g->n, g->m) == -1){
+		return -1;
+	}
+
+	while(1){
+		if(threadStopped(w)){
+			sliced_free(&batch);
+			return 0;
+		}
+
+		unsigned int lane = 0;
+
+		sliced_random(&batch, &w->rng);
+		unsigned int edgeCount = sliced_count(g, &batch, &lane);
+
+		if(edgeCount < ring_best(circ_buf)){
+			sliced_extract(&batch, lane, &w->out);
+			publish(w, g, &w->out, edgeCount);
 		}
 	}
+}
+
+/**
+ * Send a coloring to the supervisor.
+ *
+ * @brief Claims the new best and sends the conflicting edges of the coloring if the claim
+ * succeeded. Nothing is locked, see ring.h. The edges the claim took off the best count for the
+ * portfolio turn of the worker.
+ *
+ * @param w the worker
+ * @param g the graph
+ * @param c the coloring
+ * @param edgeCount the number of conflicting edges of c
+ *
+ */
 
-	int vertex[maxIdx+1];
+static void publish(struct worker *w, const struct graph *g, const struct coloring *c,
+	unsigned int edgeCount){
+	/*Only the generator that lowers the best gets to send.*/
+	unsigned int gain = ring_claim_best(circ_buf, edgeCount);
 
-	for(int i = 0; i <= maxIdx; i++){
-		vertex[i] = (rand() % 3) + 1;
+	if(gain > 0){
+		/*The first solution only counts one edge, there was no best to improve on.*/
+		((struct hooks *)w->hooks)->gain += edgeCount + gain > circ_buf->maxEdges ? 1 : gain;
+		sendToSupervisor(g, c, edgeCount);
 	}
+}
 
-	char setEdges[8][12];
-	
-	for(int i = 0; i < 8; i++){
-		setEdges[i][0] = '\0';	
+/**
+ * Parse a numeric option.
+ * @brief Calls usage() if str is not a number in [min, max].
+ *
+ * @param str the option argument
+ * @param min smallest allowed value
+ * @param max largest allowed value
+ *
+ * @return the number
+ */
+
+static double parseNumber(const char *str, double min, double max){
+	char *end;
+	double val;
+
+	errno = 0;
+	val = strtod(str, &end);
+	if(errno != 0 || end == str || *end != '\0' || !(val >= min && val <= max)){
+		usage();
 	}
-	unsigned int edgeCount = 0;
+	return val;
+}
 
-	int notValid = 0;
+/**
+ * Parse the seed.
+ * @brief Calls usage() if str is not an unsigned 64 bit number (decimal, hex with 0x or octal).
+ */
 
-	for(int i = 0; i <= maxIdx; i++){
-		for(int j = 0; j <= maxIdx; j++){
-			if(vertex[i] == vertex[j] && (workEdges[i][j] == 1 || workEdges[j][i] == 1)){
-				if(workEdges[i][j] == 1){
-					workEdges[i][j] = 0;
-				}
+static uint64_t parseSeed(const char *str){
+	char *end;
+	unsigned long long val;
 
-				if(workEdges[j][i] == 1){
-					workEdges[j][i] = 0;
-				}
-				
-				char *toAppend = malloc(sizeof(char)*10);
-				
-				if(toAppend == NULL){
-					cleanup();
-					err_msg("Could not allocate any more memory!\n");
-				}
-				
-				sprintf(toAppend,"%d-%d ",i,j);
-				strcpy(setEdges[edgeCount],toAppend);
-				
-				if(setEdges == NULL){
-					cleanup();
-					err_msg("Error when pasting result of computation.\n");
-				}
-				
+	errno = 0;
+	val = strtoull(str, &end, 0);
+	if(errno != 0 || end == str || *end != '\0' || *str == '-'){
+		usage();
+	}
+	return val;
+}
 
-				edgeCount++;
-			}
-			
-			if(edgeCount >= circ_buf->edgeCount){
-				notValid = 1;
-				break;
+/**
+ * Cancellation check for the search strategies.
+ * @return 1 if the generator has to stop, see stopped()
+ */
+
+int search_cancelled(struct worker *w){
+	return stopped();
+}
+
+/**
+ * Termination check for the search strategies.
+ * @return 1 if the thread has to stop (see threadStopped()), during a block-wise search also if
+ * the block is conflict-free or its time slice is over
+ */
+
+int search_stopped(struct worker *w){
+	struct blockrun *run = ((struct hooks *)w->hooks)->run;
+
+	if(threadStopped(w)){
+		return 1;
+	}
+	if(run == NULL){
+		return 0;
+	}
+	if(run->conflicts[run->current] == 0){
+		return 1;
+	}
+	if(run->timed){
+		struct timespec now;
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return now.tv_sec > run->deadline.tv_sec || (now.tv_sec == run->deadline.tv_sec &&
+			now.tv_nsec >= run->deadline.tv_nsec);
+	}
+	return 0;
+}
+
+/**
+ * Current best for the search strategies.
+ * @return the number of edges of the best solution the supervisor knows, during a block-wise
+ * search that of the best coloring of the block
+ */
+
+unsigned int search_bound(struct worker *w){
+	struct blockrun *run = ((struct hooks *)w->hooks)->run;
+
+	return run != NULL ? run->conflicts[run->current] : ring_best(circ_buf);
+}
+
+/**
+ * Report a coloring found by a search strategy.
+ * @brief Packs the color array and publishes it like the random strategies do. During a
+ * block-wise search the coloring is kept for its block and the composed coloring is published.
+ *
+ * @param w the worker
+ * @param color one color per vertex
+ * @param conflicts the number of conflicting edges of the coloring
+ *
+ */
+
+void search_report(struct worker *w, const unsigned char *color, unsigned int conflicts){
+	struct blockrun *run = ((struct hooks *)w->hooks)->run;
+
+	if(run == NULL){
+		coloring_from_bytes(&w->out, color);
+		publish(w, w->g, &w->out, conflicts);
+		return;
+	}
+
+	/*A better coloring of the current block, the whole graph may now beat the supervisor's best.*/
+	memcpy(run->best[run->current], color, w->g->n);
+	run->total -= run->conflicts[run->current] - conflicts;
+	run->conflicts[run->current] = conflicts;
+	if(run->total < ring_best(circ_buf)){
+		reportBlocks(w, run);
+	}
+}
+
+/**
+ * Start coloring for the search strategies.
+ * @brief Copies a random coloring of the elite pool and perturbs it, or colors randomly if the
+ * pool is empty, the copy fails or the dice say so. During a block-wise search only the vertices
+ * of the block are taken from the elite coloring.
+ *
+ * @param w the worker
+ * @param color set to one color per vertex of w->g
+ */
+
+void search_start(struct worker *w, unsigned char *color){
+	const struct graph *g = w->g;
+	struct blockrun *run = ((struct hooks *)w->hooks)->run;
+	uint32_t filled = __atomic_load_n(&circ_buf->eliteFilled, __ATOMIC_ACQUIRE);
+	int elite = 0;
+
+	if(filled > 0 && rng_below(&w->rng, ELITE_ODDS) != 0){
+		unsigned int n = circ_buf->graphN;
+		uint32_t *words = malloc((size_t)circ_buf->colorWords*sizeof(uint32_t));
+		unsigned char *full = run != NULL ? run->color : color;
+
+		if(words != NULL && ring_elite_get(circ_buf, rng_below(&w->rng, filled), words) != -1){
+			coloring_unpack(words, n, full);
+			if(run != NULL){
+				const unsigned int *vmap = reduction.blocks[run->current].vmap;
+
+				for(unsigned int v = 0; v < g->n; v++){
+					color[v] = full[vmap[v]];
+				}
 			}
+			elite = 1;
 		}
-		if(edgeCount >= circ_buf->edgeCount){
-			notValid = 1;
-			break;
+		free(words);
+	}
+
+	for(unsigned int v = 0; v < g->n; v++){
+		if(!elite || rng_below(&w->rng, ELITE_PERTURB) == 0){
+			color[v] = rng_color(&w->rng);
 		}
 	}
-	
-	//Edge Count <= 8
+}
 
-	/*Legal Solution*/
-	if(notValid == 0){
-		
-		int size_arr = 0; 
+/**
+ * Claim a subtree for the exact strategy.
+ * @brief Leases a subtree, see ring_claim_subtree(). While all subtrees left are leased by other
+ * threads, waits for one of them to be done or to be given up.
+ *
+ * @param w the worker
+ * @param subtrees the number of subtrees of the search tree
+ *
+ * @return the number of the subtree, subtrees once all are done or the thread has to stop
+ */
 
-		for(int i = 0; i < circ_buf->edgeCount && setEdges[i][0] != '\0'; i++){
-			size_arr += strlen(setEdges[i]);
+uint64_t search_claim(struct worker *w, uint64_t subtrees){
+	struct hooks *h = w->hooks;
+	struct timespec pause = {0, CLAIM_WAIT_MS * 1000000L};
+	uint64_t subtree;
+
+	while((subtree = ring_claim_subtree(circ_buf, subtrees, &h->lease)) == RING_SUBTREE_BUSY){
+		if(threadStopped(w)){
+			return subtrees;
 		}
+		nanosleep(&pause, NULL);
+	}
+	h->leased = subtree < subtrees;
+	h->subtree = subtree;
+	return subtree;
+}
 
-		char solution[100];
-		solution[0] = '\0';
+/**
+ * Report a subtree searched by the exact strategy.
+ * @brief The last one proves the best solution optimal, see ring_subtree_done().
+ *
+ * @param w the worker
+ * @param subtree the subtree
+ * @param subtrees the number of subtrees of the search tree
+ */
 
-		for(int i = 0; i < circ_buf->edgeCount && setEdges[i][0] != '\0'; i++){
-			strncat(solution,setEdges[i],strlen(setEdges[i]));
-			if(solution == NULL){
-				cleanup();
-				err_msg("Could not concatenate result.\n");
-			}
-		}		
+void search_done(struct worker *w, uint64_t subtree, uint64_t subtrees){
+	((struct hooks *)w->hooks)->leased = 0;
+	ring_subtree_done(circ_buf, subtree, subtrees);
+}
 
-		solution[strlen(solution)-1] = '\0';
+/**
+ * Parents for the evolutionary strategy.
+ * @brief Copies two different random colorings of the elite pool.
+ *
+ * @param w the worker
+ * @param a,b set to one color per vertex
+ *
+ * @return 1 if both were copied, 0 if the pool has fewer than two colorings or a copy failed
+ */
 
-		sem_wait(mtex_sem);
-		if(edgeCount < circ_buf->edgeCount){
-			sendToSupervisor(solution,edgeCount);
-		}
-		sem_post(mtex_sem);
+int search_parents(struct worker *w, unsigned char *a, unsigned char *b){
+	uint32_t filled = __atomic_load_n(&circ_buf->eliteFilled, __ATOMIC_ACQUIRE);
+	unsigned int n = circ_buf->graphN;
+	int ok = 0;
+
+	if(filled < 2){
+		return 0;
+	}
+
+	uint32_t *words = malloc((size_t)circ_buf->colorWords*sizeof(uint32_t));
+	uint32_t i = rng_below(&w->rng, filled);
+	uint32_t j = rng_below(&w->rng, filled-1);
 
+	j += j >= i;
+	if(words != NULL && ring_elite_get(circ_buf, i, words) != -1){
+		coloring_unpack(words, n, a);
+		if(ring_elite_get(circ_buf, j, words) != -1){
+			coloring_unpack(words, n, b);
+			ok = 1;
 		}
+	}
+	free(words);
+	return ok;
+}
 
-	}	
+/**
+ * Send an offspring of the evolutionary strategy.
+ * @brief Sends the coloring as an offspring record (see ring.h), whether it beats the best solution
+ * or not. The supervisor decides if it enters the elite pool.
+ *
+ * @param w the worker
+ * @param color one color per vertex
+ * @param conflicts the number of conflicting edges of the coloring
+ */
+
+void search_offspring(struct worker *w, const unsigned char *color, unsigned int conflicts){
+	uint32_t pos;
+	uint32_t *record = ring_reserve(circ_buf, &pos, producerStopped);
+
+	if(record == NULL){
+		return;
+	}
+	coloring_from_bytes(&w->out, color);
+	record[0] = RING_OFFSPRING;
+	record[1] = conflicts;
+	coloring_pack(&w->out, record+2);
+	ring_commit(circ_buf, pos);
 }
 
 /**
@@ -242,75 +1082,124 @@ static void createSendSolution(int maxIdx, int edges[][maxIdx+1]){
  * @brief This function sets up shared memory used by the generator.
  *
  * @details Resources must be created by the supervisor. The generator merely "connects" to the 
- * supervisors provided memory.
+ * supervisors provided memory, the one of the job given with -J: it maps the header, checks that
+ * its supervisor is still running (ring_orphaned()), magic and version (ring_check()) and
+ * then maps the ring with the size the supervisor chose, and the graph behind it read-only if
+ * there is one. Once mapped, it takes the cancellation epoch and attaches (ring_attach()); if the
+ * supervisor is already shutting down the threads stop at once. The descriptor stays open, the
+ * threads check the lock of the supervisor with it while they search (see threadStopped()). A
+ * generator never unlinks the segment, it belongs to the supervisor.
  * 
  */
 
 static void setup_shm(){
 	/*Open shared Memory*/
-	int fd = shm_open(SHM_NAME, O_RDWR, 0600);
+	int fd = shm_open(shmName, O_RDWR, 0600);
+	struct stat st;
 
 	if (fd == -1){
-		close(fd);
-		shm_unlink(SHM_NAME);
 		err_msg("Could not open file descriptor.");
 	}
+	if(fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(struct circ)){
+		close(fd);
+		err_msg("Shared memory is not set up by a supervisor.");
+	}
 
-	
-	circ_buf = mmap(NULL,sizeof(*circ_buf),PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-	
+	/*Map the header first, the layout of the rest is in there.*/
+	circ_buf = mmap(NULL,sizeof(struct circ),PROT_READ, MAP_SHARED, fd, 0);
 	if (circ_buf == MAP_FAILED){
 		close(fd);
-		shm_unlink(SHM_NAME);
 		err_msg("Could not map memory.");
 	}
+	if(ring_orphaned(circ_buf, fd)){
+		munmap(circ_buf,sizeof(struct circ));
+		close(fd);
+		err_msg("The supervisor of this job is not running anymore.");
+	}
+	if(ring_check(circ_buf, st.st_size) == -1 || (circ_buf->graphBytes > 0 &&
+		circ_buf->graphBytes != graph_bytes(circ_buf->graphN, circ_buf->graphM)) ||
+		(circ_buf->colorWords > 0 && (circ_buf->graphBytes == 0 ||
+		circ_buf->colorWords != COLORING_WORDS(circ_buf->graphN)))){
+		munmap(circ_buf,sizeof(struct circ));
+		close(fd);
+		err_msg("Shared memory has an unknown layout, supervisor and generator do not match.");
+	}
 
-	if(close(fd) < 0){
-		munmap(circ_buf,sizeof(*circ_buf));
-		shm_unlink(SHM_NAME);
-		err_msg("Could not close File Descriptor.");
+	size_t graphOffset = circ_buf->graphOffset;
+
+	graph_map_size = circ_buf->graphBytes;
+	circ_size = graph_map_size > 0 ? graphOffset : circ_buf->size;
+	munmap(circ_buf,sizeof(struct circ));
+
+	circ_buf = mmap(NULL,circ_size,PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	
+	if (circ_buf == MAP_FAILED){
+		close(fd);
+		err_msg("Could not map memory.");
 	}
 
-	/*Look for Semaphores*/
-	free_sem = sem_open(SEM_1,0);
-	used_sem = sem_open(SEM_2,0);
-	mtex_sem = sem_open(MTEX,0);
+	if(graph_map_size > 0){
+		graph_map = mmap(NULL,graph_map_size,PROT_READ, MAP_SHARED, fd, graphOffset);
+		if(graph_map == MAP_FAILED){
+			graph_map = NULL;
+			munmap(circ_buf,circ_size);
+			close(fd);
+			err_msg("Could not map the graph.");
+		}
+	}
 
-	if(free_sem == SEM_FAILED || used_sem == SEM_FAILED || mtex_sem == SEM_FAILED){
-		cleanup();
-		err_msg("Could not connect to semaphores!\n");
+	epoch = ring_epoch(circ_buf);
+	ring_attach(circ_buf);
+	if(ring_terminated(circ_buf) || ring_proven(circ_buf)){
+		local_stop = 1;
 	}
+
+	/*The descriptor stays open for the checks of threadStopped().*/
+	shm_fd = fd;
 }
 
 /**
  * Send solution to supervisor. 
  *
- * @brief This function sends a solution to the supervisor. If the supervisor hasn't freed space
- * the program waits on the supervisor here.
+ * @brief This function writes the conflicting edges of a coloring as a binary record straight into
+ * a slot of the ring. If the ring is full the thread sleeps until the supervisor has freed a slot.
  *
- * @details Here also the variable circ_buf->edgeCount is set. This also changes the behavior of
- * possible other generators. 
+ * @details circ_buf->edgeCount has already been lowered by ring_claim_best(), which changes the
+ * behavior of possible other generators, and guarantees that the record fits into a slot. The edge
+ * indices are collected into the pair area first and then expanded to (u, v) pairs from the back,
+ * so neither a string nor an allocation is needed. If the supervisor keeps an elite pool, the
+ * packed coloring follows the pairs. Nothing is sent once the supervisor shuts down, the search
+ * threads notice the termination flag themselves and return.
  *
- * @param solution the solution sent to the supervisor
+ * @param g the graph
+ * @param c the coloring
  * @param edgeCount the number of edges that need to be removed
  *
  */
 
-static void sendToSupervisor(char solution[], unsigned int edgeCount){
-	if(circ_buf->termination == 1){
-		exit_graceful();
-	}
-	sem_wait(free_sem);
+static void sendToSupervisor(const struct graph *g, const struct coloring *c,
+	unsigned int edgeCount){
+	uint32_t pos;
+	uint32_t *record = ring_reserve(circ_buf, &pos, producerStopped);
 
-	strncpy(circ_buf->solutions[circ_buf->write_pos],solution,strlen(solution));
-	/*Set EdgeCount*/
-	if(edgeCount < circ_buf->edgeCount){
-		circ_buf->edgeCount = edgeCount;
+	if(record == NULL){
+		return;
 	}
-	circ_buf->write_pos = (circ_buf->write_pos + 1) % CIRC_BUF_LEN;
 
-	sem_post(used_sem);
+	uint32_t *pairs = record+1;
+	unsigned int k = collect_conflicts(g, c, pairs, edgeCount);
 
+	for(unsigned int i = k; i > 0; i--){
+		unsigned int e = pairs[i-1];
+
+		pairs[2*(i-1)] = graph_id(g, g->eu[e]);
+		pairs[2*(i-1)+1] = graph_id(g, g->ev[e]);
+	}
+	record[0] = k;
+	if(circ_buf->colorWords > 0){
+		coloring_pack(c, record + 1 + 2*k);
+	}
+	ring_commit(circ_buf, pos);
 }
 
 /**
@@ -319,7 +1208,9 @@ static void sendToSupervisor(char solution[], unsigned int edgeCount){
  */
 
 static void usage(){
-	err_msg("Synopsis = ./generator 0-1 1-2 ...");
+	err_msg("Synopsis = ./generator [-s random|sliced|minconf|anneal|exact|evolve|auto]"
+		" [-T temp] [-a cooling] [-L steps] [-t threads] [-J job] [--seed n] [--no-reduce]"
+		" [-f file | 0-1 1-2 ...]");
 }
 
 /**
@@ -345,75 +1236,49 @@ static void exit_graceful(){
 }
 
 /**
- * Clean up resources.
- * @brief If anything not in the ordinary happened use this function to clean up resources.
- * @details Most of the unusual stuff is handled by the supervisor - hence the shortness here.
- *
+ * Handles SIGINT, SIGTERM and SIGALRM.
+ * @brief SIGINT and SIGTERM let the search threads stop and return like on a shutdown of the
+ * supervisor, and make sure the generator ends STOP_GRACE_S seconds later if a thread does not:
+ * then SIGALRM detaches from the shared memory and exits at once.
  */
 
-static void cleanup(){
-	if(munmap(circ_buf,sizeof(*circ_buf)) == -1){
-		err_msg("Could not unmap Memory!\n");
+static void signal_handler(int signal){
+	if(signal == SIGINT || signal == SIGTERM){
+		local_stop = 1;
+		alarm(STOP_GRACE_S);
+	} else if(signal == SIGALRM){
+		detach();
+		_exit(EXIT_FAILURE);
 	}
+}
 
-	if(sem_close(free_sem) == -1 || sem_close(used_sem) == -1){
-		err_msg("Could not close Semaphores.\n");
+/**
+ * Detach from the shared memory.
+ * @brief Once, whether the main path or the SIGALRM handler gets there first (see ring_detach()).
+ * Async-signal-safe.
+ */
+
+static void detach(){
+	if(!__atomic_exchange_n(&detached, 1, __ATOMIC_SEQ_CST)){
+		ring_detach(circ_buf);
 	}
 }
 
-/** 
- * Get number of vertices.
- * @brief This function gets called from main and calculates the number of vertices. This has a
- * dependency towards the adjacency matrix that is needed later on for the generation of randomly 
- * colored graphs.
- *
- * @details The input is also sanitized here.
- *
- * @param args the input vector.
- * @param len argc-1 --> number of edges to be considered
+/**
+ * Clean up resources.
+ * @brief If anything not in the ordinary happened use this function to clean up resources.
+ * @details Most of the unusual stuff is handled by the supervisor - hence the shortness here. The
+ * generator detaches from the shared memory first (detach()).
  *
  */
 
-static int getMax(char *args[], int len){
-	int i = 0;
-	int curr_max = 0;
-	int first,second;
-
-	while (i <= len && args[i] != NULL){
-		char *checkStr;
-
-		first = strtol(args[i],&checkStr,10);
-		
-		if(errno == ERANGE){
-			err_msg("Under- or overflow ocured.\n");
-		}
-
-		if(checkStr == args[i] || *checkStr == '\0'){
-			err_msg("could not parse first vertex.");
-		}
-
-		second = strtol(strchr(args[i],'-')+1,&checkStr,10);
-	
-		if(errno == ERANGE){
-			err_msg("Under- or overflow ocured.\n");
-		}
-
-		if(checkStr == strchr(args[i],'-')+1){
-			err_msg("problem with casting second number");
-		}
-
-		if(first == second){
-			err_msg("No loops allowed");
-		}
-
-		if(first > curr_max){
-			curr_max = first;
-		}  	
-		if(second > curr_max){
-			curr_max = second;
-		}
-	
-		i++;
+static void cleanup(){
+	detach();
+	if(munmap(circ_buf,circ_size) == -1 ||
+		(graph_map != NULL && munmap(graph_map,graph_map_size) == -1)){
+		err_msg("Could not unmap Memory!\n");
+	}
+	if(shm_fd != -1 && close(shm_fd) == -1){
+		err_msg("Could not close File Descriptor.");
 	}
-	return curr_max;
 }
@@ -0,0 +1,217 @@
+/**
+ * @file bound.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Packing edge-disjoint odd wheels (see bound.h).
+ *
+ * @details For a hub h the neighbors of h that are still joined to it by an unused edge form a
+ * graph over the unused edges between them. A breadth-first search in there that meets an edge
+ * (a, b) with both ends on the same level has found an odd cycle: the tree paths from a and b up
+ * to where they meet and the edge itself, 2d+1 edges for paths of length d. Together with h it is
+ * a wheel, all its edges are marked used and the hub is tried again.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "bound.h"
+
+#define NONE UINT_MAX
+
+/**
+ * Find an edge.
+ * @return the index of the edge between u and v, which must exist
+ */
+
+static unsigned int edge_index(const struct graph *g, unsigned int u, unsigned int v){
+	unsigned int a = u < v ? u : v;
+	unsigned int b = u < v ? v : u;
+	unsigned int lo = 0;
+	unsigned int hi = g->m;
+
+	while(lo < hi){
+		unsigned int mid = lo + (hi - lo) / 2;
+
+		if(g->eu[mid] < a || (g->eu[mid] == a && g->ev[mid] < b)){
+			lo = mid+1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/**
+ * Set up a packing.
+ *
+ * @param p the packing
+ * @param g the graph, must outlive the packing
+ * @param seed seed for the shuffled orders
+ *
+ * @return 0 on success, -1 if there is not enough memory
+ */
+
+int bound_init(struct packing *p, const struct graph *g, uint64_t seed){
+	size_t n = g->n > 0 ? g->n : 1;
+
+	memset(p, 0, sizeof(*p));
+	p->g = g;
+	rng_seed(&p->rng, seed);
+	p->used = malloc(g->m > 0 ? g->m : 1);
+	p->order = malloc(n*sizeof(unsigned int));
+	p->mark = calloc(n, sizeof(unsigned int));
+	p->dist = malloc(n*sizeof(unsigned int));
+	p->parent = malloc(n*sizeof(unsigned int));
+	p->queue = malloc(n*sizeof(unsigned int));
+	p->cycle = malloc(2*n*sizeof(unsigned int));
+	if(p->used == NULL || p->order == NULL || p->mark == NULL || p->dist == NULL ||
+		p->parent == NULL || p->queue == NULL || p->cycle == NULL){
+		bound_free(p);
+		return -1;
+	}
+	for(unsigned int v = 0; v < g->n; v++){
+		p->order[v] = v;
+	}
+	return 0;
+}
+
+/**
+ * Free a packing.
+ */
+
+void bound_free(struct packing *p){
+	free(p->used);
+	free(p->order);
+	free(p->mark);
+	free(p->dist);
+	free(p->parent);
+	free(p->queue);
+	free(p->cycle);
+	memset(p, 0, sizeof(*p));
+}
+
+/**
+ * Find an odd wheel around a hub.
+ * @brief Searches the unused edges for an odd cycle in the neighborhood of h and marks the wheel
+ * used if there is one.
+ *
+ * @return 1 if a wheel was found, 0 otherwise
+ */
+
+static int find_wheel(struct packing *p, unsigned int h){
+	const struct graph *g = p->g;
+	unsigned int stamp = ++p->stamp;
+
+	for(unsigned int i = g->off[h]; i < g->off[h+1]; i++){
+		unsigned int x = g->adj[i];
+
+		if(!p->used[edge_index(g, h, x)]){
+			p->mark[x] = stamp;
+			p->dist[x] = NONE;
+		}
+	}
+
+	for(unsigned int i = g->off[h]; i < g->off[h+1]; i++){
+		unsigned int r = g->adj[i];
+		unsigned int head = 0;
+		unsigned int tail = 0;
+
+		if(p->mark[r] != stamp || p->dist[r] != NONE){
+			continue;
+		}
+		p->dist[r] = 0;
+		p->parent[r] = NONE;
+		p->queue[tail++] = r;
+
+		while(head < tail){
+			unsigned int a = p->queue[head++];
+
+			for(unsigned int j = g->off[a]; j < g->off[a+1]; j++){
+				unsigned int b = g->adj[j];
+
+				if(p->mark[b] != stamp || p->used[edge_index(g, a, b)]){
+					continue;
+				}
+				if(p->dist[b] == NONE){
+					p->dist[b] = p->dist[a] + 1;
+					p->parent[b] = a;
+					p->queue[tail++] = b;
+					continue;
+				}
+				if(p->dist[b] != p->dist[a]){
+					continue;
+				}
+
+				/*Odd cycle: a up to the common ancestor, then down to b. The path from b is
+				collected behind the first n entries and copied back reversed.*/
+				unsigned int *up = p->cycle + g->n;
+				unsigned int len = 0;
+				unsigned int x = a;
+				unsigned int y = b;
+
+				while(x != y){
+					p->cycle[len] = x;
+					up[len++] = y;
+					x = p->parent[x];
+					y = p->parent[y];
+				}
+				p->cycle[len] = x;
+				for(unsigned int k = 0; k < len; k++){
+					p->cycle[len+1+k] = up[len-1-k];
+				}
+				len = 2*len + 1;
+
+				/*cycle[] runs a .. ancestor .. b, the edge (b, a) closes it.*/
+				for(unsigned int k = 0; k < len; k++){
+					unsigned int c = p->cycle[k];
+
+					p->used[edge_index(g, h, c)] = 1;
+					p->used[edge_index(g, c, p->cycle[(k+1) % len])] = 1;
+				}
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+/**
+ * Pack odd wheels.
+ * @brief Tries every vertex as hub, as often as it yields a wheel.
+ *
+ * @param p the packing
+ * @param shuffle 0 to try the hubs by increasing number, otherwise in a random order
+ * @param stop the packing stops early (with the wheels found so far) once *stop is set
+ *
+ * @return the number of edge-disjoint odd wheels found, a lower bound on the edges to remove
+ */
+
+unsigned int bound_pack(struct packing *p, int shuffle, const volatile int *stop){
+	const struct graph *g = p->g;
+	unsigned int wheels = 0;
+
+	memset(p->used, 0, g->m);
+	if(shuffle){
+		for(unsigned int i = g->n; i > 1; i--){
+			unsigned int j = rng_below(&p->rng, i);
+			unsigned int t = p->order[i-1];
+
+			p->order[i-1] = p->order[j];
+			p->order[j] = t;
+		}
+	}
+
+	for(unsigned int i = 0; i < g->n && !*stop; i++){
+		unsigned int h = p->order[i];
+
+		if(g->off[h+1] - g->off[h] < 3){
+			continue;
+		}
+		while(find_wheel(p, h)){
+			wheels++;
+		}
+	}
+	return wheels;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file bound.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Lower bounds on the number of edges that have to be removed.
+ *
+ * @details An odd wheel (a hub joined to every vertex of an odd cycle, K4 is the smallest) cannot
+ * be colored with 3 colors, so every coloring has a conflicting edge in it. Wheels that share no
+ * edge therefore need as many removed edges as there are wheels. bound_pack() packs edge-disjoint
+ * odd wheels greedily; the result depends on the order the hubs are tried in, so repeated calls
+ * with shuffled orders may find larger packings.
+ *
+ */
+
+#ifndef BOUND_H
+#define BOUND_H
+
+#include "graph.h"
+#include "rng.h"
+
+struct packing{
+	const struct graph *g;
+	struct rng rng;
+	unsigned char *used;
+	unsigned int *order;
+	unsigned int *mark;
+	unsigned int *dist;
+	unsigned int *parent;
+	unsigned int *queue;
+	unsigned int *cycle;
+	unsigned int stamp;
+};
+
+int bound_init(struct packing *p, const struct graph *g, uint64_t seed);
+void bound_free(struct packing *p);
+unsigned int bound_pack(struct packing *p, int shuffle, const volatile int *stop);
+
+#endif
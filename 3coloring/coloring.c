@@ -0,0 +1,469 @@
+/**
+ * @file coloring.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Random bit-packed colorings and counting of conflicting edges.
+ *
+ * @details Counting walks the edge array and compares the two bits of both endpoints. On CPUs
+ * with AVX2 eight edges are handled at once: the 32 bit words that hold the endpoint bits are
+ * gathered from both planes, shifted into place and compared, and the equal lanes are counted
+ * with a popcount of the compare mask. The AVX2 code is compiled with a target attribute and
+ * selected at runtime, so the binary still runs everywhere.
+ *
+ * The bit-sliced evaluation keeps one vertical counter per lane: counter bit k of all lanes lives
+ * in one vector, so adding the conflict mask of an edge is a ripple of ANDs and XORs over the
+ * planes. Edges are first summed into a small 4 bit counter and only every 15 edges added into the
+ * wide one. The kernel is built for AVX2 and for the baseline, the dynamic loader picks one.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+/*Check the bound only every that many edges, the check costs more than an edge.*/
+#define LIMIT_CHECK 64
+
+typedef unsigned int (*count_fn)(const struct graph *, const struct coloring *, unsigned int);
+
+static unsigned int count_scalar(const struct graph *g, const struct coloring *c, unsigned int limit);
+static count_fn count_impl = NULL;
+
+/**
+ * Allocate a coloring.
+ * @brief Allocates both planes for n vertices, all vertices get color 0.
+ *
+ * @return 0 on success, -1 if there is not enough memory
+ */
+
+int coloring_init(struct coloring *c, unsigned int n){
+	c->n = n;
+	c->words = (n+63)/64;
+	c->lo = calloc(c->words+1, sizeof(uint64_t));
+	c->hi = calloc(c->words+1, sizeof(uint64_t));
+
+	if(c->lo == NULL || c->hi == NULL){
+		coloring_free(c);
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * Free a coloring.
+ * @brief Releases both planes.
+ */
+
+void coloring_free(struct coloring *c){
+	free(c->lo);
+	free(c->hi);
+	c->lo = NULL;
+	c->hi = NULL;
+}
+
+/**
+ * Color randomly.
+ * @brief Gives every vertex one of the three colors, uniformly and independently.
+ *
+ * @details Both planes are filled 64 vertices at a time. Lanes that end up with the invalid
+ * combination 3 (both bits set) are drawn again until none is left, which keeps the three colors
+ * equally likely without any modulo.
+ *
+ */
+
+void coloring_random(struct coloring *c, struct rng *r){
+	for(unsigned int w = 0; w < c->words; w++){
+		uint64_t lo = rng_next(r);
+		uint64_t hi = rng_next(r);
+		uint64_t bad = lo & hi;
+
+		while(bad != 0){
+			lo = (lo & ~bad) | (rng_next(r) & bad);
+			hi = (hi & ~bad) | (rng_next(r) & bad);
+			bad = lo & hi;
+		}
+		c->lo[w] = lo;
+		c->hi[w] = hi;
+	}
+}
+
+/**
+ * Pack a color array.
+ * @brief Sets the planes from an array with one color (0 to 2) per vertex.
+ */
+
+void coloring_from_bytes(struct coloring *c, const unsigned char *color){
+	memset(c->lo, 0, c->words*sizeof(uint64_t));
+	memset(c->hi, 0, c->words*sizeof(uint64_t));
+
+	for(unsigned int v = 0; v < c->n; v++){
+		c->lo[v >> 6] |= (uint64_t)(color[v] & 1) << (v & 63);
+		c->hi[v >> 6] |= (uint64_t)(color[v] >> 1) << (v & 63);
+	}
+}
+
+/**
+ * Store a coloring compactly.
+ * @brief Writes 2 bits per vertex, vertex v in bits 2*(v%16) and up of dst[v/16]. This is how
+ * colorings travel through the shared memory.
+ *
+ * @param c the coloring
+ * @param dst COLORING_WORDS(c->n) words
+ */
+
+void coloring_pack(const struct coloring *c, uint32_t *dst){
+	memset(dst, 0, COLORING_WORDS(c->n)*sizeof(uint32_t));
+	for(unsigned int v = 0; v < c->n; v++){
+		dst[v >> 4] |= (uint32_t)coloring_get(c, v) << (2*(v & 15));
+	}
+}
+
+/**
+ * Unpack a stored coloring.
+ * @brief The reverse of coloring_pack(), into one byte per vertex.
+ */
+
+void coloring_unpack(const uint32_t *src, unsigned int n, unsigned char *color){
+	for(unsigned int v = 0; v < n; v++){
+		color[v] = (src[v >> 4] >> (2*(v & 15))) & 3;
+	}
+}
+
+/**
+ * Distance of two stored colorings.
+ * @brief The number of vertices whose color differs, with the colors of b renamed to match a as
+ * well as possible: colorings that only differ by the names of their colors have distance 0.
+ *
+ * @details Counts how often every pair (color in a, color in b) occurs and takes the best of the six
+ * ways to rename the colors of b.
+ *
+ * @param a,b colorings as stored by coloring_pack()
+ * @param n the number of vertices
+ *
+ * @return the distance, at most n
+ */
+
+unsigned int coloring_distance(const uint32_t *a, const uint32_t *b, unsigned int n){
+	static const unsigned char perms[6][3] = {
+		{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}
+	};
+	unsigned int pairs[4][4] = {{0}};
+	unsigned int same = 0;
+
+	for(unsigned int v = 0; v < n; v++){
+		unsigned int shift = 2*(v & 15);
+
+		pairs[(a[v >> 4] >> shift) & 3][(b[v >> 4] >> shift) & 3]++;
+	}
+	for(unsigned int p = 0; p < 6; p++){
+		unsigned int kept = pairs[0][perms[p][0]] + pairs[1][perms[p][1]] + pairs[2][perms[p][2]];
+
+		if(kept > same){
+			same = kept;
+		}
+	}
+	return n - same;
+}
+
+#ifdef HAVE_AVX2_KERNEL
+
+/**
+ * Count conflicts with AVX2.
+ * @brief Same as count_scalar(), eight edges per step.
+ *
+ * @details The planes are read as arrays of 32 bit words (little endian), so the bit of vertex v
+ * is bit (v & 31) of word (v >> 5).
+ *
+ */
+
+__attribute__((target("avx2")))
+static unsigned int count_avx2(const struct graph *g, const struct coloring *c, unsigned int limit){
+	const int *lo = (const int *)c->lo;
+	const int *hi = (const int *)c->hi;
+	const __m256i low5 = _mm256_set1_epi32(31);
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i zero = _mm256_setzero_si256();
+	unsigned int count = 0;
+	unsigned int e = 0;
+
+	for(; e+8 <= g->m; e += 8){
+		__m256i u = _mm256_loadu_si256((const __m256i *)(g->eu+e));
+		__m256i v = _mm256_loadu_si256((const __m256i *)(g->ev+e));
+		__m256i uw = _mm256_srli_epi32(u, 5);
+		__m256i vw = _mm256_srli_epi32(v, 5);
+		__m256i us = _mm256_and_si256(u, low5);
+		__m256i vs = _mm256_and_si256(v, low5);
+
+		__m256i lu = _mm256_srlv_epi32(_mm256_i32gather_epi32(lo, uw, 4), us);
+		__m256i lv = _mm256_srlv_epi32(_mm256_i32gather_epi32(lo, vw, 4), vs);
+		__m256i hu = _mm256_srlv_epi32(_mm256_i32gather_epi32(hi, uw, 4), us);
+		__m256i hv = _mm256_srlv_epi32(_mm256_i32gather_epi32(hi, vw, 4), vs);
+
+		__m256i diff = _mm256_and_si256(_mm256_or_si256(_mm256_xor_si256(lu, lv),
+			_mm256_xor_si256(hu, hv)), one);
+		__m256i same = _mm256_cmpeq_epi32(diff, zero);
+
+		count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(same)));
+		if((e % LIMIT_CHECK) == LIMIT_CHECK-8 && count >= limit){
+			return count;
+		}
+	}
+	for(; e < g->m; e++){
+		count += coloring_get(c, g->eu[e]) == coloring_get(c, g->ev[e]);
+	}
+	return count;
+}
+
+#endif
+
+/**
+ * Count conflicts.
+ * @brief Portable version: the comparison results of up to 64 edges are collected in one word
+ * and counted with a popcount.
+ *
+ */
+
+static unsigned int count_scalar(const struct graph *g, const struct coloring *c, unsigned int limit){
+	unsigned int count = 0;
+
+	for(unsigned int base = 0; base < g->m; base += LIMIT_CHECK){
+		unsigned int end = base+LIMIT_CHECK < g->m ? base+LIMIT_CHECK : g->m;
+		uint64_t same = 0;
+
+		for(unsigned int e = base; e < end; e++){
+			unsigned int u = g->eu[e];
+			unsigned int v = g->ev[e];
+			uint64_t diff = ((c->lo[u >> 6] >> (u & 63)) ^ (c->lo[v >> 6] >> (v & 63))) |
+				((c->hi[u >> 6] >> (u & 63)) ^ (c->hi[v >> 6] >> (v & 63)));
+
+			same |= (~diff & 1) << (e-base);
+		}
+		count += __builtin_popcountll(same);
+		if(count >= limit){
+			return count;
+		}
+	}
+	return count;
+}
+
+/**
+ * Count conflicting edges.
+ * @brief Returns the number of edges whose endpoints have the same color.
+ *
+ * @details Counting may stop early once limit is reached, the result is then some number that is
+ * at least limit. The implementation is picked on the first call.
+ *
+ * @param g the graph
+ * @param c the coloring
+ * @param limit stop once this many conflicts are found
+ *
+ */
+
+unsigned int count_conflicts(const struct graph *g, const struct coloring *c, unsigned int limit){
+	if(count_impl == NULL){
+		count_impl = count_scalar;
+#ifdef HAVE_AVX2_KERNEL
+		if(__builtin_cpu_supports("avx2")){
+			count_impl = count_avx2;
+		}
+#endif
+	}
+	return count_impl(g, c, limit);
+}
+
+/**
+ * List conflicting edges.
+ * @brief Writes the indices of up to max conflicting edges into out.
+ *
+ * @return the number of conflicting edges, which may be larger than max
+ */
+
+unsigned int collect_conflicts(const struct graph *g, const struct coloring *c, unsigned int *out,
+	unsigned int max){
+	unsigned int count = 0;
+
+	for(unsigned int e = 0; e < g->m; e++){
+		if(coloring_get(c, g->eu[e]) == coloring_get(c, g->ev[e])){
+			if(count < max){
+				out[count] = e;
+			}
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+ * Allocate a batch of bit-sliced colorings.
+ * @brief Allocates the lo and hi vector of every vertex and enough counter planes to count up to
+ * m conflicts per lane.
+ *
+ * @return 0 on success, -1 if there is not enough memory
+ */
+
+int sliced_init(struct sliced *s, unsigned int n, unsigned int m){
+	s->n = n;
+	s->planes = 1;
+	while(s->planes < 32 && (m >> s->planes) != 0){
+		s->planes++;
+	}
+	s->lo = NULL;
+	s->hi = NULL;
+	s->cnt = NULL;
+
+	if(posix_memalign((void **)&s->lo, sizeof(slice_t), (n > 0 ? n : 1)*sizeof(slice_t)) != 0 ||
+		posix_memalign((void **)&s->hi, sizeof(slice_t), (n > 0 ? n : 1)*sizeof(slice_t)) != 0 ||
+		posix_memalign((void **)&s->cnt, sizeof(slice_t), s->planes*sizeof(slice_t)) != 0){
+		sliced_free(s);
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * Free a batch of bit-sliced colorings.
+ * @brief Releases all vectors.
+ */
+
+void sliced_free(struct sliced *s){
+	free(s->lo);
+	free(s->hi);
+	free(s->cnt);
+	s->lo = NULL;
+	s->hi = NULL;
+	s->cnt = NULL;
+}
+
+/**
+ * Color all lanes randomly.
+ * @brief Every lane gets an independent uniform random coloring, drawn like in coloring_random().
+ */
+
+void sliced_random(struct sliced *s, struct rng *r){
+	for(unsigned int v = 0; v < s->n; v++){
+		for(int w = 0; w < SLICE_WORDS; w++){
+			uint64_t lo = rng_next(r);
+			uint64_t hi = rng_next(r);
+			uint64_t bad = lo & hi;
+
+			while(bad != 0){
+				lo = (lo & ~bad) | (rng_next(r) & bad);
+				hi = (hi & ~bad) | (rng_next(r) & bad);
+				bad = lo & hi;
+			}
+			s->lo[v][w] = lo;
+			s->hi[v][w] = hi;
+		}
+	}
+}
+
+/**
+ * Add the small counter.
+ * @brief Adds the 4 bit vertical numbers in small to the wide counter in cnt.
+ */
+
+static inline void add_small(slice_t *cnt, unsigned int planes, const slice_t *small){
+	slice_t carry = {0};
+
+	for(unsigned int k = 0; k < planes; k++){
+		slice_t b = k < 4 ? small[k] : (slice_t){0};
+		slice_t a = cnt[k];
+		slice_t x = a ^ b;
+
+		cnt[k] = x ^ carry;
+		carry = (a & b) | (carry & x);
+	}
+}
+
+/**
+ * Count conflicts of all lanes.
+ * @brief One pass over the edges, afterwards cnt holds the number of conflicting edges of every
+ * lane in bit-sliced form.
+ */
+
+#ifdef HAVE_AVX2_KERNEL
+__attribute__((target_clones("avx2","default")))
+#endif
+static void sliced_pass(const struct graph *g, struct sliced *s){
+	slice_t small[4];
+	unsigned int pending = 0;
+
+	memset(s->cnt, 0, s->planes*sizeof(slice_t));
+	memset(small, 0, sizeof(small));
+
+	for(unsigned int e = 0; e < g->m; e++){
+		unsigned int u = g->eu[e];
+		unsigned int v = g->ev[e];
+		slice_t carry = ~((s->lo[u] ^ s->lo[v]) | (s->hi[u] ^ s->hi[v]));
+		slice_t t;
+
+		t = small[0] & carry;
+		small[0] ^= carry;
+		carry = t;
+		t = small[1] & carry;
+		small[1] ^= carry;
+		carry = t;
+		t = small[2] & carry;
+		small[2] ^= carry;
+		carry = t;
+		small[3] ^= carry;
+
+		if(++pending == 15){
+			add_small(s->cnt, s->planes, small);
+			memset(small, 0, sizeof(small));
+			pending = 0;
+		}
+	}
+	add_small(s->cnt, s->planes, small);
+}
+
+/**
+ * Evaluate all lanes.
+ * @brief Counts the conflicts of every lane and returns the smallest count.
+ *
+ * @param g the graph
+ * @param s the batch of colorings
+ * @param lane set to a lane with the smallest count
+ *
+ * @return the smallest number of conflicting edges among all lanes
+ */
+
+unsigned int sliced_count(const struct graph *g, struct sliced *s, unsigned int *lane){
+	unsigned int best = ~0u;
+
+	sliced_pass(g, s);
+
+	for(unsigned int l = 0; l < SLICE_LANES; l++){
+		unsigned int count = 0;
+
+		for(unsigned int k = 0; k < s->planes; k++){
+			count |= (unsigned int)((s->cnt[k][l/64] >> (l%64)) & 1) << k;
+		}
+		if(count < best){
+			best = count;
+			*lane = l;
+		}
+	}
+	return best;
+}
+
+/**
+ * Extract one lane.
+ * @brief Copies the coloring of one lane into a bit-plane coloring.
+ */
+
+void sliced_extract(const struct sliced *s, unsigned int lane, struct coloring *c){
+	memset(c->lo, 0, c->words*sizeof(uint64_t));
+	memset(c->hi, 0, c->words*sizeof(uint64_t));
+
+	for(unsigned int v = 0; v < s->n; v++){
+		c->lo[v >> 6] |= ((s->lo[v][lane/64] >> (lane%64)) & 1) << (v & 63);
+		c->hi[v >> 6] |= ((s->hi[v][lane/64] >> (lane%64)) & 1) << (v & 63);
+	}
+}
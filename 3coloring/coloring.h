@@ -0,0 +1,78 @@
+/**
+ * @file coloring.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Bit-packed 3-colorings and conflict counting.
+ *
+ * @details A coloring is stored as two bit-planes: bit v of lo and bit v of hi together form the
+ * color of vertex v (0, 1 or 2, the combination 3 never occurs). Two vertices have the same color
+ * exactly if both planes agree, so an edge is in conflict if
+ * ((lo[u] ^ lo[v]) | (hi[u] ^ hi[v])) is zero for its endpoints.
+ *
+ * A struct sliced holds SLICE_LANES independent colorings in bit-sliced form: every vertex has
+ * one lo and one hi vector and bit l of them is the color of the vertex in coloring l. One pass
+ * over the edges evaluates all lanes at once.
+ *
+ */
+
+#ifndef COLORING_H
+#define COLORING_H
+
+#include <stdint.h>
+#include "graph.h"
+#include "rng.h"
+
+/*Number of 64 bit words per slice vector, 4 gives 256 colorings per pass.*/
+#ifndef SLICE_WORDS
+#define SLICE_WORDS 4
+#endif
+#define SLICE_LANES (64*SLICE_WORDS)
+
+/*Size of a coloring of n vertices stored by coloring_pack(), in uint32_t.*/
+#define COLORING_WORDS(n) (((n) + 15) / 16)
+
+typedef uint64_t slice_t __attribute__((vector_size(8*SLICE_WORDS)));
+
+struct coloring{
+	unsigned int n;
+	unsigned int words;
+	uint64_t *lo;
+	uint64_t *hi;
+};
+
+struct sliced{
+	unsigned int n;
+	unsigned int planes;
+	slice_t *lo;
+	slice_t *hi;
+	slice_t *cnt;
+};
+
+int coloring_init(struct coloring *c, unsigned int n);
+void coloring_free(struct coloring *c);
+void coloring_random(struct coloring *c, struct rng *r);
+void coloring_from_bytes(struct coloring *c, const unsigned char *color);
+void coloring_pack(const struct coloring *c, uint32_t *dst);
+void coloring_unpack(const uint32_t *src, unsigned int n, unsigned char *color);
+unsigned int coloring_distance(const uint32_t *a, const uint32_t *b, unsigned int n);
+unsigned int count_conflicts(const struct graph *g, const struct coloring *c, unsigned int limit);
+unsigned int collect_conflicts(const struct graph *g, const struct coloring *c, unsigned int *out,
+	unsigned int max);
+
+int sliced_init(struct sliced *s, unsigned int n, unsigned int m);
+void sliced_free(struct sliced *s);
+void sliced_random(struct sliced *s, struct rng *r);
+unsigned int sliced_count(const struct graph *g, struct sliced *s, unsigned int *lane);
+void sliced_extract(const struct sliced *s, unsigned int lane, struct coloring *c);
+
+/**
+ * Color of a vertex.
+ * @return the color (0, 1 or 2) of vertex v
+ */
+
+static inline unsigned int coloring_get(const struct coloring *c, unsigned int v){
+	return ((c->lo[v >> 6] >> (v & 63)) & 1) | (((c->hi[v >> 6] >> (v & 63)) & 1) << 1);
+}
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file conflict.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Maintaining the neighbor color counts and the set of conflicting vertices.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "conflict.h"
+
+/**
+ * Add a vertex to the conflict set.
+ * @brief Does nothing if the vertex is already in the set.
+ */
+
+static void set_add(struct conflicts *cs, unsigned int v){
+	if(cs->pos[v] == CONFLICT_NONE){
+		cs->pos[v] = cs->size;
+		cs->set[cs->size++] = v;
+	}
+}
+
+/**
+ * Remove a vertex from the conflict set.
+ * @brief The last vertex of the set takes its place. Does nothing if the vertex is not in the set.
+ */
+
+static void set_remove(struct conflicts *cs, unsigned int v){
+	unsigned int i = cs->pos[v];
+
+	if(i != CONFLICT_NONE){
+		unsigned int last = cs->set[--cs->size];
+
+		cs->set[i] = last;
+		cs->pos[last] = i;
+		cs->pos[v] = CONFLICT_NONE;
+	}
+}
+
+/**
+ * Allocate the bookkeeping for a graph.
+ * @brief The state is only valid after the first conflict_assign().
+ *
+ * @param cs the state to set up
+ * @param g the graph, must outlive the state
+ *
+ * @return 0 on success, -1 if there is not enough memory
+ */
+
+int conflict_init(struct conflicts *cs, const struct graph *g){
+	size_t n = g->n > 0 ? g->n : 1;
+
+	cs->g = g;
+	cs->color = malloc(n);
+	cs->gamma = malloc(3*n*sizeof(unsigned int));
+	cs->set = malloc(n*sizeof(unsigned int));
+	cs->pos = malloc(n*sizeof(unsigned int));
+	cs->size = 0;
+	cs->total = 0;
+
+	if(cs->color == NULL || cs->gamma == NULL || cs->set == NULL || cs->pos == NULL){
+		conflict_free(cs);
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * Free the bookkeeping.
+ */
+
+void conflict_free(struct conflicts *cs){
+	free(cs->color);
+	free(cs->gamma);
+	free(cs->set);
+	free(cs->pos);
+	memset(cs, 0, sizeof(*cs));
+}
+
+/**
+ * Start from a coloring.
+ * @brief Copies the coloring and rebuilds all counts with one walk over the edges.
+ *
+ * @param cs the state
+ * @param color one color (0 to 2) per vertex
+ */
+
+void conflict_assign(struct conflicts *cs, const unsigned char *color){
+	const struct graph *g = cs->g;
+
+	memcpy(cs->color, color, g->n);
+	memset(cs->gamma, 0, 3*(size_t)g->n*sizeof(unsigned int));
+	memset(cs->pos, 0xFF, (size_t)g->n*sizeof(unsigned int));
+	cs->size = 0;
+	cs->total = 0;
+
+	for(unsigned int e = 0; e < g->m; e++){
+		unsigned int u = g->eu[e];
+		unsigned int v = g->ev[e];
+
+		cs->gamma[3*(size_t)u+color[v]]++;
+		cs->gamma[3*(size_t)v+color[u]]++;
+		if(color[u] == color[v]){
+			cs->total++;
+			set_add(cs, u);
+			set_add(cs, v);
+		}
+	}
+}
+
+/**
+ * Recolor a vertex.
+ * @brief Updates the counts of the neighbors, the total and the conflict set in O(degree).
+ *
+ * @param cs the state
+ * @param v the vertex
+ * @param c its new color
+ */
+
+void conflict_move(struct conflicts *cs, unsigned int v, unsigned int c){
+	const struct graph *g = cs->g;
+	unsigned int old = cs->color[v];
+
+	if(c == old){
+		return;
+	}
+	cs->total += conflict_delta(cs, v, c);
+	cs->color[v] = c;
+
+	for(unsigned int i = g->off[v]; i < g->off[v+1]; i++){
+		unsigned int u = g->adj[i];
+		unsigned int *gu = cs->gamma + 3*(size_t)u;
+
+		gu[old]--;
+		gu[c]++;
+		/*Only u's conflict status can change, by the edge to v.*/
+		if(cs->color[u] == old && gu[old] == 0){
+			set_remove(cs, u);
+		} else if(cs->color[u] == c){
+			set_add(cs, u);
+		}
+	}
+
+	if(cs->gamma[3*(size_t)v+c] > 0){
+		set_add(cs, v);
+	} else {
+		set_remove(cs, v);
+	}
+}
@@ -0,0 +1,51 @@
+/**
+ * @file conflict.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Incremental conflict bookkeeping for searches that recolor one vertex at a time.
+ *
+ * @details For every vertex v and color c, gamma[3*v+c] is the number of neighbors of v that have
+ * color c, so v is in conflict exactly if gamma[3*v+color[v]] is not zero and recoloring v to c
+ * changes the number of conflicting edges by gamma[3*v+c] - gamma[3*v+color[v]].
+ *
+ * The vertices in conflict are kept in set[0..size) with pos[v] being the index of v in set (or
+ * CONFLICT_NONE), so membership changes and picking a conflicting vertex by index are O(1).
+ * conflict_move() updates everything in O(degree).
+ *
+ */
+
+#ifndef CONFLICT_H
+#define CONFLICT_H
+
+#include "graph.h"
+
+#define CONFLICT_NONE 0xFFFFFFFFu
+
+struct conflicts{
+	const struct graph *g;
+	unsigned char *color;
+	unsigned int *gamma;
+	unsigned int *set;
+	unsigned int *pos;
+	unsigned int size;
+	unsigned int total;
+};
+
+int conflict_init(struct conflicts *cs, const struct graph *g);
+void conflict_free(struct conflicts *cs);
+void conflict_assign(struct conflicts *cs, const unsigned char *color);
+void conflict_move(struct conflicts *cs, unsigned int v, unsigned int c);
+
+/**
+ * Effect of a recoloring.
+ * @return the change of the number of conflicting edges if v gets color c
+ */
+
+static inline int conflict_delta(const struct conflicts *cs, unsigned int v, unsigned int c){
+	const unsigned int *gv = cs->gamma + 3*(size_t)v;
+
+	return (int)gv[c] - (int)gv[cs->color[v]];
+}
+
+#endif
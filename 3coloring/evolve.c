@@ -0,0 +1,118 @@
+/**
+ * @file evolve.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Evolutionary strategy for the generator.
+ *
+ * @details The population is the elite pool of the supervisor (see ring.h). Every generator thread
+ * breeds: it takes two parents from the pool (search_parents()), crosses them with the greedy
+ * partition crossover (GPX) and improves the child with one min-conflicts run
+ * (search_improve()). The child goes back to the supervisor as an offspring
+ * (search_offspring()), which decides whether it enters the population and which member it
+ * replaces. An offspring that beats the best solution is also reported like any other coloring.
+ *
+ * GPX builds the child class by class: the child gets the largest color class of one parent, the
+ * vertices of that class are then ignored in both parents, the next class comes from the other
+ * parent and so on. Vertices left over after three classes get random colors. A color class is
+ * conflict-free in a good coloring, so the child keeps large conflict-free parts of both parents,
+ * no matter how the parents named their colors.
+ *
+ * Until the pool holds two colorings, children are start colorings as search_start() gives them.
+ *
+ */
+
+#include <stdlib.h>
+#include "search.h"
+
+/*Marks a vertex the crossover has not colored yet.*/
+#define FREE 0xFF
+
+/**
+ * Greedy partition crossover.
+ * @brief Colors child from the color classes of a and b, see above. The parent giving the first
+ * class is chosen randomly.
+ */
+
+static void crossover(struct worker *w, const unsigned char *a, const unsigned char *b,
+	unsigned char *child){
+	const struct graph *g = w->g;
+	unsigned int first = rng_below(&w->rng, 2);
+
+	for(unsigned int v = 0; v < g->n; v++){
+		child[v] = FREE;
+	}
+
+	for(unsigned int c = 0; c < 3; c++){
+		const unsigned char *p = (first + c) % 2 == 0 ? a : b;
+		unsigned int size[3] = {0, 0, 0};
+		unsigned int largest = 0;
+
+		for(unsigned int v = 0; v < g->n; v++){
+			if(child[v] == FREE){
+				size[p[v]]++;
+			}
+		}
+		for(unsigned int k = 1; k < 3; k++){
+			if(size[k] > size[largest]){
+				largest = k;
+			}
+		}
+		for(unsigned int v = 0; v < g->n; v++){
+			if(child[v] == FREE && p[v] == largest){
+				child[v] = c;
+			}
+		}
+	}
+
+	for(unsigned int v = 0; v < g->n; v++){
+		if(child[v] == FREE){
+			child[v] = rng_color(&w->rng);
+		}
+	}
+}
+
+/**
+ * Evolutionary search.
+ * @brief Breeds and improves children until the generator has to stop.
+ *
+ * @param w the worker
+ *
+ * @return 0 once the generator has to stop, -1 if there is not enough memory
+ */
+
+int search_evolve(struct worker *w){
+	const struct graph *g = w->g;
+	size_t n = g->n > 0 ? g->n : 1;
+	unsigned char *a = malloc(n);
+	unsigned char *b = malloc(n);
+	unsigned char *child = malloc(n);
+	int ret = 0;
+
+	if(a == NULL || b == NULL || child == NULL){
+		ret = -1;
+		goto out;
+	}
+
+	while(!search_stopped(w)){
+		if(search_parents(w, a, b)){
+			crossover(w, a, b, child);
+		} else {
+			search_start(w, child);
+		}
+
+		int conflicts = search_improve(w, child);
+
+		if(conflicts == -1){
+			ret = -1;
+			break;
+		}
+		search_offspring(w, child, conflicts);
+	}
+
+out:
+	free(a);
+	free(b);
+	free(child);
+	return ret;
+}
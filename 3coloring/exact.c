@@ -0,0 +1,335 @@
+/**
+ * @file exact.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Exact branch and bound strategy for the generator.
+ *
+ * @details The vertices of the 3-core (see reduce.h) are colored one at a time in DSATUR order:
+ * next is the uncolored vertex with the most different colors among its colored neighbors, ties go
+ * to the higher degree and then the lower number. Every color is tried, cheapest (fewest colored
+ * neighbors with that color) first. A color nobody uses yet is only tried once, as the lowest
+ * unused one, because renaming colors does not change the conflicts.
+ *
+ * A branch is cut as soon as its conflicts plus a lower bound for the rest reach the best the
+ * supervisor knows. The bound is the sum over all uncolored vertices of the conflicts their
+ * cheapest color would add with the colored ones, an edge between colored and uncolored vertices
+ * only counts for its uncolored end. Vertices outside the 3-core are colored greedily at the end
+ * and never conflict.
+ *
+ * The choices on the first EXACT_SPLIT levels number the subtrees of the search (choice i on
+ * level l is digit i of the number in base 3), which the threads of all generators lease through
+ * search_claim(). The order only depends on the graph, so every generator splits the tree the same
+ * way. A subtree whose generator stopped halfway is handed out again once its lease ran out. Once
+ * every subtree has been searched, the best solution is optimal.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "search.h"
+#include "reduce.h"
+
+/*Levels of the search tree that are split into subtrees, 3^EXACT_SPLIT subtrees at most, which
+must not exceed RING_SUBTREES.*/
+#define EXACT_SPLIT 8
+
+/*How often the search checks for termination, in search tree nodes. Cancellation is checked by
+the work done, see SEARCH_CANCEL_WORK.*/
+#define EXACT_STOP_CHECK 4096
+
+struct exact{
+	struct worker *w;
+	const struct graph *g;
+	struct reduction core;
+	unsigned char *color;
+	unsigned int *gamma;
+	unsigned int *verts;
+	unsigned int *deg;
+	unsigned int count;
+	unsigned int left;
+	unsigned int used;
+	unsigned int cost;
+	unsigned int rest;
+	unsigned int depth;
+	unsigned int split;
+	uint64_t subtree;
+	uint64_t subtrees;
+	unsigned long nodes;
+	unsigned long work;
+	int stop;
+	unsigned char *full;
+};
+
+/**
+ * Cheapest color.
+ * @return the conflicts the cheapest color of v would add with its colored neighbors
+ */
+
+static unsigned int cheapest(const struct exact *x, unsigned int v){
+	const unsigned int *gv = x->gamma + 3*(size_t)v;
+	unsigned int m = gv[0] < gv[1] ? gv[0] : gv[1];
+
+	return m < gv[2] ? m : gv[2];
+}
+
+/**
+ * Color a vertex of the core.
+ * @brief Updates the conflicts, the neighbor color counts and the lower bound of the uncolored
+ * neighbors.
+ */
+
+static void assign(struct exact *x, unsigned int v, unsigned int c){
+	const struct graph *g = x->g;
+
+	x->cost += x->gamma[3*(size_t)v+c];
+	x->rest -= cheapest(x, v);
+	x->color[v] = c;
+	x->left--;
+	for(unsigned int i = g->off[v]; i < g->off[v+1]; i++){
+		unsigned int u = g->adj[i];
+
+		if(x->deg[u] == 0){
+			continue;
+		}
+		if(x->color[u] == UNCOLORED){
+			unsigned int old = cheapest(x, u);
+
+			x->gamma[3*(size_t)u+c]++;
+			x->rest += cheapest(x, u) - old;
+		} else {
+			x->gamma[3*(size_t)u+c]++;
+		}
+	}
+}
+
+/**
+ * Take back assign().
+ */
+
+static void unassign(struct exact *x, unsigned int v){
+	const struct graph *g = x->g;
+	unsigned int c = x->color[v];
+
+	for(unsigned int i = g->off[v]; i < g->off[v+1]; i++){
+		unsigned int u = g->adj[i];
+
+		if(x->deg[u] == 0){
+			continue;
+		}
+		if(x->color[u] == UNCOLORED){
+			unsigned int old = cheapest(x, u);
+
+			x->gamma[3*(size_t)u+c]--;
+			x->rest -= old - cheapest(x, u);
+		} else {
+			x->gamma[3*(size_t)u+c]--;
+		}
+	}
+	x->color[v] = UNCOLORED;
+	x->left++;
+	x->rest += cheapest(x, v);
+	x->cost -= x->gamma[3*(size_t)v+c];
+}
+
+/**
+ * DSATUR choice.
+ * @return the uncolored core vertex with the most different neighbor colors, then the highest
+ * degree in the core
+ */
+
+static unsigned int select_vertex(const struct exact *x){
+	unsigned int best = 0;
+	unsigned int bestSat = 0;
+	unsigned int bestDeg = 0;
+	int found = 0;
+
+	for(unsigned int i = 0; i < x->count; i++){
+		unsigned int v = x->verts[i];
+
+		if(x->color[v] != UNCOLORED){
+			continue;
+		}
+
+		const unsigned int *gv = x->gamma + 3*(size_t)v;
+		unsigned int sat = (gv[0] > 0) + (gv[1] > 0) + (gv[2] > 0);
+
+		if(!found || sat > bestSat || (sat == bestSat && x->deg[v] > bestDeg)){
+			best = v;
+			bestSat = sat;
+			bestDeg = x->deg[v];
+			found = 1;
+		}
+	}
+	return best;
+}
+
+/**
+ * Report a complete coloring of the core.
+ * @brief Colors the rest of the graph and hands the coloring to search_report().
+ */
+
+static void report(struct exact *x){
+	memcpy(x->full, x->color, x->g->n);
+	reduce_color_peeled(&x->core, x->full);
+	search_report(x->w, x->full, x->cost);
+}
+
+/**
+ * Search a node.
+ * @brief Colors the next vertex with every allowed color in turn and recurses. Above the split
+ * depth only the color given by the subtree number is tried.
+ */
+
+static void branch(struct exact *x){
+	if(x->stop){
+		return;
+	}
+	if(++x->nodes % EXACT_STOP_CHECK == 0 && search_stopped(x->w)){
+		x->stop = 1;
+		return;
+	}
+	/*Selecting the vertex looks at every vertex of the core.*/
+	x->work += x->count;
+	if(x->work >= SEARCH_CANCEL_WORK){
+		x->work = 0;
+		if(search_cancelled(x->w)){
+			x->stop = 1;
+			return;
+		}
+	}
+	if(x->cost + x->rest >= search_bound(x->w)){
+		return;
+	}
+	if(x->left == 0){
+		report(x);
+		return;
+	}
+
+	unsigned int v = select_vertex(x);
+	const unsigned int *gv = x->gamma + 3*(size_t)v;
+	unsigned int allowed = x->used < 3 ? x->used + 1 : 3;
+	unsigned int order[3] = {0, 1, 2};
+
+	/*Cheapest first, a stable insertion sort of the allowed colors.*/
+	for(unsigned int i = 1; i < allowed; i++){
+		for(unsigned int j = i; j > 0 && gv[order[j]] < gv[order[j-1]]; j--){
+			unsigned int t = order[j];
+
+			order[j] = order[j-1];
+			order[j-1] = t;
+		}
+	}
+
+	unsigned int first = 0;
+	unsigned int last = allowed;
+
+	if(x->depth < x->split){
+		uint64_t digit = 1;
+
+		for(unsigned int i = x->depth+1; i < x->split; i++){
+			digit *= 3;
+		}
+		first = x->subtree / digit % 3;
+		last = first+1;
+		if(first >= allowed){
+			return;
+		}
+	}
+
+	for(unsigned int i = first; i < last && !x->stop; i++){
+		unsigned int c = order[i];
+		unsigned int used = x->used;
+
+		if(c == x->used){
+			x->used++;
+		}
+		assign(x, v, c);
+		x->depth++;
+		branch(x);
+		x->depth--;
+		unassign(x, v);
+		x->used = used;
+	}
+}
+
+/**
+ * Free the search state.
+ */
+
+static void exact_free(struct exact *x){
+	reduce_free(&x->core);
+	free(x->color);
+	free(x->gamma);
+	free(x->verts);
+	free(x->deg);
+	free(x->full);
+}
+
+/**
+ * Exact branch and bound.
+ * @brief Claims subtrees and searches them completely until none is left or the generator has to
+ * stop. Every subtree searched to the end is reported with search_done().
+ *
+ * @param w the worker
+ *
+ * @return 0 once no subtree is left or the generator has to stop, -1 if there is not enough
+ * memory
+ */
+
+int search_exact(struct worker *w){
+	const struct graph *g = w->g;
+	size_t n = g->n > 0 ? g->n : 1;
+	struct exact x;
+
+	memset(&x, 0, sizeof(x));
+	x.w = w;
+	x.g = g;
+	x.color = malloc(n);
+	x.gamma = calloc(3*n, sizeof(unsigned int));
+	x.verts = malloc(n*sizeof(unsigned int));
+	x.deg = calloc(n, sizeof(unsigned int));
+	x.full = malloc(n);
+	if(x.color == NULL || x.gamma == NULL || x.verts == NULL || x.deg == NULL || x.full == NULL ||
+		reduce_init(&x.core, g, 0) == -1){
+		exact_free(&x);
+		return -1;
+	}
+
+	/*deg is the degree within the core, 0 for the vertices outside.*/
+	memset(x.color, UNCOLORED, g->n);
+	memset(x.full, 1, g->n);
+	for(unsigned int i = 0; i < x.core.peeled; i++){
+		x.full[x.core.order[i]] = 0;
+	}
+	for(unsigned int v = 0; v < g->n; v++){
+		if(!x.full[v]){
+			continue;
+		}
+		x.verts[x.count++] = v;
+		for(unsigned int i = g->off[v]; i < g->off[v+1]; i++){
+			x.deg[v] += x.full[g->adj[i]];
+		}
+	}
+	x.left = x.count;
+	x.split = x.count < EXACT_SPLIT ? x.count : EXACT_SPLIT;
+	x.subtrees = 1;
+	for(unsigned int i = 0; i < x.split; i++){
+		x.subtrees *= 3;
+	}
+
+	while(!search_stopped(w)){
+		x.subtree = search_claim(w, x.subtrees);
+		if(x.subtree >= x.subtrees){
+			break;
+		}
+		branch(&x);
+		if(x.stop){
+			break;
+		}
+		search_done(w, x.subtree, x.subtrees);
+	}
+
+	exact_free(&x);
+	return 0;
+}
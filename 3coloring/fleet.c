@@ -0,0 +1,390 @@
+/**
+ * @file fleet.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Generators started and watched by the supervisor (see fleet.h).
+ *
+ * @details The CPUs available are those of the affinity mask, but no more than the CPU quota of
+ * the cgroup allows (cpu.max for cgroup v2, cpu.cfs_quota_us and cpu.cfs_period_us for v1, as
+ * mounted under /sys/fs/cgroup), rounded up. The cgroup is the one of the process as listed in
+ * /proc/self/cgroup, and every cgroup above it up to the root may limit it further, so the
+ * smallest quota on the way counts.
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/prctl.h>
+#include "fleet.h"
+
+/**
+ * Read two numbers from a file.
+ * @return the number of numbers read, 0 if the file cannot be read
+ */
+
+static int read_pair(const char *path, long *a, long *b){
+	FILE *file = fopen(path, "r");
+	int read = 0;
+
+	if(file == NULL){
+		return 0;
+	}
+	read = fscanf(file, "%ld %ld", a, b);
+	fclose(file);
+	return read > 0 ? read : 0;
+}
+
+/**
+ * CPU quota of one cgroup.
+ *
+ * @param dir the directory of the cgroup
+ * @param v2 1 for cgroup v2, 0 for the cpu controller of v1
+ *
+ * @return the quota in CPUs rounded up, 0 if there is none
+ */
+
+static unsigned int quota_at(const char *dir, int v2){
+	char path[PATH_MAX + sizeof("/cpu.cfs_period_us")];
+	long quota;
+	long period;
+	long unused;
+
+	/*cgroup v2: "max 100000" means no quota and does not parse as two numbers.*/
+	if(v2){
+		snprintf(path, sizeof(path), "%s/cpu.max", dir);
+		if(read_pair(path, &quota, &period) == 2 && quota > 0 && period > 0){
+			return (quota + period-1) / period;
+		}
+		return 0;
+	}
+	snprintf(path, sizeof(path), "%s/cpu.cfs_quota_us", dir);
+	if(read_pair(path, &quota, &unused) != 1 || quota <= 0){
+		return 0;
+	}
+	snprintf(path, sizeof(path), "%s/cpu.cfs_period_us", dir);
+	if(read_pair(path, &period, &unused) != 1 || period <= 0){
+		return 0;
+	}
+	return (quota + period-1) / period;
+}
+
+/**
+ * Does a cgroup v1 hierarchy have the cpu controller.
+ * @brief Splits controllers, which is changed.
+ *
+ * @return 1 if "cpu" is one of the comma separated controllers
+ */
+
+static int has_cpu(char *controllers){
+	char *save = NULL;
+
+	for(char *c = strtok_r(controllers, ",", &save); c != NULL; c = strtok_r(NULL, ",", &save)){
+		if(strcmp(c, "cpu") == 0){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * CPU quota of the cgroup.
+ * @brief Walks from the cgroup of the process (v2 and the cpu hierarchy of v1) up to the root.
+ *
+ * @return the smallest quota in CPUs rounded up, 0 if there is none
+ */
+
+static unsigned int cgroup_quota(){
+	FILE *file = fopen("/proc/self/cgroup", "r");
+	char line[PATH_MAX];
+	unsigned int smallest = 0;
+
+	if(file == NULL){
+		return 0;
+	}
+	/*Lines are "id:controllers:path", v2 has id 0 and no controllers.*/
+	while(fgets(line, sizeof(line), file) != NULL){
+		char *controllers = strchr(line, ':');
+		char *path = controllers != NULL ? strchr(controllers+1, ':') : NULL;
+		char dir[PATH_MAX];
+		int v2;
+
+		if(path == NULL){
+			continue;
+		}
+		*controllers++ = '\0';
+		*path++ = '\0';
+		path[strcspn(path, "\n")] = '\0';
+		v2 = strcmp(line, "0") == 0 && *controllers == '\0';
+		if(!v2 && !has_cpu(controllers)){
+			continue;
+		}
+		if(snprintf(dir, sizeof(dir), "%s%s", v2 ? "/sys/fs/cgroup" : "/sys/fs/cgroup/cpu",
+			path) >= (int)sizeof(dir)){
+			continue;
+		}
+
+		/*The path ends at the mount point, a cgroup namespace may hide the levels above.*/
+		size_t root = strlen(v2 ? "/sys/fs/cgroup" : "/sys/fs/cgroup/cpu");
+
+		while(1){
+			unsigned int quota = quota_at(dir, v2);
+
+			if(quota > 0 && (smallest == 0 || quota < smallest)){
+				smallest = quota;
+			}
+
+			char *slash = strrchr(dir, '/');
+
+			if(strlen(dir) <= root || slash == NULL){
+				break;
+			}
+			*slash = '\0';
+		}
+	}
+	fclose(file);
+	return smallest;
+}
+
+/**
+ * Available CPUs.
+ * @return the number of CPUs the supervisor may run on, at least 1
+ */
+
+unsigned int fleet_cpus(){
+	cpu_set_t set;
+	unsigned int cpus;
+
+	if(sched_getaffinity(0, sizeof(set), &set) == 0){
+		cpus = CPU_COUNT(&set);
+	} else {
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+		cpus = online > 0 ? online : 1;
+	}
+
+	unsigned int quota = cgroup_quota();
+
+	if(quota > 0 && quota < cpus){
+		cpus = quota;
+	}
+	return cpus > 0 ? cpus : 1;
+}
+
+/**
+ * Start the generator of a place.
+ * @brief Forks. The child gets an empty signal mask (the watching thread blocks the signals the
+ * supervisor handles), asks for SIGTERM once the supervisor dies, pins itself to the CPU of the
+ * place and executes the generator.
+ *
+ * @return the process id, or -1 if fork() failed
+ */
+
+static pid_t spawn(const struct fleet *f, const struct member *m){
+	pid_t pid = fork();
+
+	if(pid != 0){
+		return pid;
+	}
+
+	sigset_t none;
+
+	sigemptyset(&none);
+	sigprocmask(SIG_SETMASK, &none, NULL);
+	prctl(PR_SET_PDEATHSIG, SIGTERM);
+	if(getppid() != f->parent){
+		_exit(EXIT_FAILURE);
+	}
+	if(m->cpu >= 0){
+		cpu_set_t one;
+
+		CPU_ZERO(&one);
+		CPU_SET(m->cpu, &one);
+		sched_setaffinity(0, sizeof(one), &one);
+	}
+	execv(f->argv[0], f->argv);
+	_exit(127);
+}
+
+/**
+ * Watch the generators.
+ * @brief Thread function. Starts every place, then reaps exited generators and restarts the ones
+ * that crashed, until no generator is left. Then calls the ended callback, unless the fleet is
+ * being stopped.
+ *
+ * @details The thread has to do the forking: the death signal of a child follows the thread that
+ * forked it.
+ *
+ * @return NULL
+ */
+
+static void *watch(void *arg){
+	struct fleet *f = arg;
+
+	pthread_mutex_lock(&f->lock);
+	for(unsigned int i = 0; i < f->count && !f->stopping; i++){
+		f->members[i].pid = spawn(f, &f->members[i]);
+	}
+	pthread_mutex_unlock(&f->lock);
+
+	while(1){
+		int status;
+		pid_t pid = waitpid(-1, &status, 0);
+
+		if(pid == -1){
+			if(errno == EINTR){
+				continue;
+			}
+			break;
+		}
+
+		pthread_mutex_lock(&f->lock);
+		for(unsigned int i = 0; i < f->count; i++){
+			struct member *m = &f->members[i];
+
+			if(m->pid != pid){
+				continue;
+			}
+			m->pid = 0;
+			if(f->stopping || !WIFSIGNALED(status) || m->restarts >= FLEET_RESTARTS){
+				break;
+			}
+
+			long pause = (long)FLEET_BACKOFF_MS << m->restarts;
+			struct timespec wait = {pause / 1000, pause % 1000 * 1000000L};
+
+			m->restarts++;
+			fprintf(stderr, "Generator %d died of signal %d, restarting it.\n", (int)pid,
+				WTERMSIG(status));
+			pthread_mutex_unlock(&f->lock);
+			nanosleep(&wait, NULL);
+			pthread_mutex_lock(&f->lock);
+			if(!f->stopping){
+				m->pid = spawn(f, m);
+			}
+			break;
+		}
+		pthread_mutex_unlock(&f->lock);
+	}
+
+	pthread_mutex_lock(&f->lock);
+
+	int stopping = f->stopping;
+
+	pthread_mutex_unlock(&f->lock);
+	if(!stopping && f->ended != NULL){
+		f->ended();
+	}
+	return NULL;
+}
+
+/**
+ * Start generators.
+ * @brief The thread calling it should block the signals the program handles, the watching thread
+ * inherits the mask.
+ *
+ * @param f the fleet
+ * @param argv the generator command line, argv[0] is the path of the executable, must outlive the
+ * fleet
+ * @param count the number of generators
+ * @param ended called from the watching thread once all generators have ended on their own, may
+ * be NULL
+ * @param why set to the reason on failure
+ *
+ * @return 0 on success, -1 on failure
+ */
+
+int fleet_start(struct fleet *f, char *const *argv, unsigned int count, void (*ended)(),
+	const char **why){
+	cpu_set_t set;
+	int pinned = sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0;
+	int cpu = -1;
+
+	memset(f, 0, sizeof(*f));
+	f->argv = argv;
+	f->count = count;
+	f->ended = ended;
+	f->parent = getpid();
+	f->members = calloc(count > 0 ? count : 1, sizeof(struct member));
+	if(f->members == NULL){
+		*why = "Could not allocate any more memory!";
+		return -1;
+	}
+
+	/*Round-robin over the CPUs of the mask.*/
+	for(unsigned int i = 0; i < count; i++){
+		if(pinned){
+			do{
+				cpu = (cpu + 1) % CPU_SETSIZE;
+			} while(!CPU_ISSET(cpu, &set));
+		}
+		f->members[i].cpu = cpu;
+	}
+
+	pthread_mutex_init(&f->lock, NULL);
+	if(pthread_create(&f->thread, NULL, watch, f) != 0){
+		pthread_mutex_destroy(&f->lock);
+		free(f->members);
+		*why = "Could not start the thread watching the generators.";
+		return -1;
+	}
+	f->running = 1;
+	return 0;
+}
+
+/**
+ * Stop the generators.
+ * @brief Gives them FLEET_GRACE_MS to end after they have been told to stop through the ring,
+ * kills the rest and waits until all are reaped.
+ *
+ * @param f the fleet, does nothing if it was never started
+ */
+
+void fleet_stop(struct fleet *f){
+	struct timespec tick = {0, 10 * 1000000L};
+
+	if(!f->running){
+		return;
+	}
+
+	pthread_mutex_lock(&f->lock);
+	f->stopping = 1;
+	pthread_mutex_unlock(&f->lock);
+
+	for(unsigned int waited = 0; waited < FLEET_GRACE_MS; waited += 10){
+		int alive = 0;
+
+		pthread_mutex_lock(&f->lock);
+		for(unsigned int i = 0; i < f->count; i++){
+			alive |= f->members[i].pid > 0;
+		}
+		pthread_mutex_unlock(&f->lock);
+		if(!alive){
+			break;
+		}
+		nanosleep(&tick, NULL);
+	}
+
+	pthread_mutex_lock(&f->lock);
+	for(unsigned int i = 0; i < f->count; i++){
+		if(f->members[i].pid > 0){
+			kill(f->members[i].pid, SIGKILL);
+		}
+	}
+	pthread_mutex_unlock(&f->lock);
+
+	pthread_join(f->thread, NULL);
+	pthread_mutex_destroy(&f->lock);
+	free(f->members);
+	f->running = 0;
+}
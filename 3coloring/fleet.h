@@ -0,0 +1,61 @@
+/**
+ * @file fleet.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Generators started and watched by the supervisor.
+ *
+ * @details fleet_start() forks and executes count generators from a thread that then waits for
+ * them. Every generator is pinned to one CPU of the supervisor's affinity mask, round-robin. A
+ * generator killed by a signal is started again, at most FLEET_RESTARTS times per place and after
+ * a growing pause; one that exits on its own (done, or an error it reported) is not. Once no
+ * generator is left and none is going to be restarted, the watching thread calls the ended
+ * callback, unless the fleet is being stopped. A generator also gets SIGTERM if the supervisor
+ * dies, so none outlives it.
+ *
+ * fleet_stop() waits for the generators to end once the supervisor has told them to stop through
+ * the ring, kills the ones that take too long and reaps all of them.
+ *
+ */
+
+#ifndef FLEET_H
+#define FLEET_H
+
+#include <sys/types.h>
+#include <pthread.h>
+
+/*A place restarts its generator at most FLEET_RESTARTS times, the first time after
+FLEET_BACKOFF_MS and twice as long every next time.*/
+#define FLEET_RESTARTS 5
+#define FLEET_BACKOFF_MS 100
+
+/*Most generators of a fleet.*/
+#define FLEET_MAX 1024
+
+/*How long fleet_stop() lets the generators end on their own.*/
+#define FLEET_GRACE_MS 2000
+
+struct member{
+	pid_t pid;
+	int cpu;
+	unsigned int restarts;
+};
+
+struct fleet{
+	char *const *argv;
+	struct member *members;
+	unsigned int count;
+	pid_t parent;
+	void (*ended)();
+	pthread_t thread;
+	pthread_mutex_t lock;
+	int stopping;
+	int running;
+};
+
+unsigned int fleet_cpus();
+int fleet_start(struct fleet *f, char *const *argv, unsigned int count, void (*ended)(),
+	const char **why);
+void fleet_stop(struct fleet *f);
+
+#endif
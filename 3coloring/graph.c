@@ -0,0 +1,795 @@
+/**
+ * @file graph.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Building the compact graph representation from the edges given on the command line or in
+ * a file.
+ *
+ * @details Functions in here do not exit on errors, they return -1 and a message for the caller,
+ * which then reports it like every other error of the program.
+ *
+ * Graph files are mapped with mmap() and never copied. A text file holds pairs of vertex numbers
+ * ("u-v", "u v", "u,v", any number per line, '#' and '%' start a comment until the end of the
+ * line). Large text files are cut at line ends into one chunk per CPU and the chunks are scanned
+ * in parallel. A binary file starts with the 8 bytes GRAPH_MAGIC, followed by the number of edges
+ * as uint64_t and the edges as pairs of uint32_t, all in host byte order.
+ *
+ * Vertex numbers in files may be sparse: if not every number from 0 to the largest one occurs,
+ * the vertices are renumbered densely in increasing order and ids[] keeps the original numbers.
+ *
+ */
+
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "graph.h"
+
+/*Text files smaller than this per thread are not split.*/
+#define PARSE_CHUNK (8u << 20)
+#define PARSE_THREADS_MAX 64
+
+/*Renumbering uses a lookup table if the largest vertex number is below this (or small compared to
+the number of edges), otherwise it sorts.*/
+#define REMAP_TABLE_MAX (1u << 20)
+
+/*One chunk of a text file, scanned by one thread.*/
+struct parse_job{
+	const unsigned char *begin;
+	const unsigned char *end;
+	uint64_t *edges;
+	size_t count;
+	size_t cap;
+	uint32_t max;
+	const char *why;
+};
+
+/**
+ * Sort 64 bit keys.
+ * @brief LSD radix sort with 16 bit digits. Digits that are the same in all keys are skipped, so
+ * keys of small graphs take two or three passes instead of four.
+ *
+ * @param a the keys
+ * @param tmp scratch space of the same size
+ * @param count the number of keys
+ *
+ * @return a or tmp, whichever holds the sorted keys
+ */
+
+static uint64_t *radix_sort(uint64_t *a, uint64_t *tmp, size_t count){
+	static size_t hist[1 << 16];
+	uint64_t any = 0;
+	uint64_t all = ~(uint64_t)0;
+
+	for(size_t i = 0; i < count; i++){
+		any |= a[i];
+		all &= a[i];
+	}
+
+	for(int shift = 0; shift < 64; shift += 16){
+		if((((any ^ all) >> shift) & 0xFFFF) == 0){
+			continue;
+		}
+		memset(hist, 0, sizeof(hist));
+		for(size_t i = 0; i < count; i++){
+			hist[(a[i] >> shift) & 0xFFFF]++;
+		}
+
+		size_t sum = 0;
+
+		for(size_t d = 0; d < (1 << 16); d++){
+			size_t h = hist[d];
+
+			hist[d] = sum;
+			sum += h;
+		}
+		for(size_t i = 0; i < count; i++){
+			tmp[hist[(a[i] >> shift) & 0xFFFF]++] = a[i];
+		}
+
+		uint64_t *swap = a;
+
+		a = tmp;
+		tmp = swap;
+	}
+	return a;
+}
+
+/**
+ * Parse a vertex.
+ * @brief Reads a non-negative decimal number that fits into an unsigned int.
+ *
+ * @param str where the number starts
+ * @param end set to the first character after the number
+ *
+ * @return the number or -1 if there is none or it is too large
+ */
+
+static long parse_vertex(const char *str, char **end){
+	long val;
+
+	if(*str < '0' || *str > '9'){
+		return -1;
+	}
+	errno = 0;
+	val = strtol(str, end, 10);
+	if(errno == ERANGE || val > (long)UINT32_MAX-1){
+		return -1;
+	}
+	return val;
+}
+
+/**
+ * Build the graph from a list of edges.
+ * @brief Sorts the edges, removes duplicates (also in reverse direction) and sets up the CSR
+ * arrays. The graph has no ids, the caller sets them if the vertices were renumbered.
+ *
+ * @param g the graph to fill
+ * @param n the number of vertices
+ * @param edges the edges packed as (min << 32) | max, reordered in place
+ * @param count the number of entries in edges
+ *
+ * @return 0 on success, -1 if there is not enough memory (then g holds nothing)
+ */
+
+int graph_from_edges(struct graph *g, unsigned int n, uint64_t *edges, size_t count){
+	size_t m = 0;
+	uint64_t *tmp = malloc((count > 0 ? count : 1)*sizeof(uint64_t));
+
+	if(tmp == NULL){
+		return -1;
+	}
+	if(radix_sort(edges, tmp, count) != edges){
+		memcpy(edges, tmp, count*sizeof(uint64_t));
+	}
+	free(tmp);
+
+	for(size_t i = 0; i < count; i++){
+		if(m == 0 || edges[m-1] != edges[i]){
+			edges[m++] = edges[i];
+		}
+	}
+
+	g->n = n;
+	g->m = m;
+	g->ids = NULL;
+	g->eu = malloc((m > 0 ? m : 1)*sizeof(unsigned int));
+	g->ev = malloc((m > 0 ? m : 1)*sizeof(unsigned int));
+	g->off = calloc(n+1, sizeof(unsigned int));
+	g->adj = malloc((m > 0 ? 2*m : 1)*sizeof(unsigned int));
+
+	if(g->eu == NULL || g->ev == NULL || g->off == NULL || g->adj == NULL){
+		graph_free(g);
+		return -1;
+	}
+
+	for(size_t e = 0; e < m; e++){
+		g->eu[e] = edges[e] >> 32;
+		g->ev[e] = edges[e] & 0xFFFFFFFFu;
+		g->off[g->eu[e]+1]++;
+		g->off[g->ev[e]+1]++;
+	}
+	for(unsigned int v = 0; v < n; v++){
+		g->off[v+1] += g->off[v];
+	}
+
+	/*Fill adjacency lists, off[v] is used as insert position and restored afterwards.*/
+	for(size_t e = 0; e < m; e++){
+		g->adj[g->off[g->eu[e]]++] = g->ev[e];
+		g->adj[g->off[g->ev[e]]++] = g->eu[e];
+	}
+	for(unsigned int v = n; v > 0; v--){
+		g->off[v] = g->off[v-1];
+	}
+	g->off[0] = 0;
+
+	return 0;
+}
+
+/**
+ * Build a graph from command line arguments.
+ * @brief Every argument is an edge written as "u-v". The vertices are numbered from 0 to the
+ * largest index that occurs.
+ *
+ * @details The input is sanitized here: both vertices must be non-negative numbers and loops
+ * are not allowed. Duplicate edges are merged.
+ *
+ * @param g the graph to fill
+ * @param args the edges
+ * @param len the number of edges
+ * @param why set to an error message if the function fails
+ *
+ * @return 0 on success, -1 on error
+ */
+
+int graph_from_args(struct graph *g, char *args[], int len, const char **why){
+	uint64_t *edges = malloc((len > 0 ? len : 1)*sizeof(uint64_t));
+	unsigned int max = 0;
+
+	memset(g, 0, sizeof(*g));
+	if(edges == NULL){
+		*why = "Could not allocate any more memory!";
+		return -1;
+	}
+
+	for(int i = 0; i < len; i++){
+		char *end;
+		long first = parse_vertex(args[i], &end);
+
+		if(first < 0 || *end != '-'){
+			free(edges);
+			*why = "could not parse first vertex.";
+			return -1;
+		}
+
+		long second = parse_vertex(end+1, &end);
+
+		if(second < 0 || *end != '\0'){
+			free(edges);
+			*why = "problem with casting second number";
+			return -1;
+		}
+		if(first == second){
+			free(edges);
+			*why = "No loops allowed";
+			return -1;
+		}
+
+		uint64_t u = first < second ? first : second;
+		uint64_t v = first < second ? second : first;
+		edges[i] = (u << 32) | v;
+		if(v > max){
+			max = v;
+		}
+	}
+
+	if(graph_from_edges(g, max+1, edges, len) == -1){
+		free(edges);
+		*why = "Could not allocate any more memory!";
+		return -1;
+	}
+	free(edges);
+	return 0;
+}
+
+/**
+ * Free a graph.
+ * @brief Releases all arrays of the graph.
+ */
+
+void graph_free(struct graph *g){
+	free(g->eu);
+	free(g->ev);
+	free(g->off);
+	free(g->adj);
+	free(g->ids);
+	memset(g, 0, sizeof(*g));
+}
+
+/**
+ * Add an edge to a parse job.
+ * @return 0 on success, -1 if there is not enough memory
+ */
+
+static int job_add(struct parse_job *job, uint64_t u, uint64_t v){
+	if(job->count == job->cap){
+		size_t cap = job->cap > 0 ? 2*job->cap : 4096;
+		uint64_t *tmp = realloc(job->edges, cap*sizeof(uint64_t));
+
+		if(tmp == NULL){
+			return -1;
+		}
+		job->edges = tmp;
+		job->cap = cap;
+	}
+	if(u > v){
+		uint64_t t = u;
+
+		u = v;
+		v = t;
+	}
+	job->edges[job->count++] = (u << 32) | v;
+	if(v > job->max){
+		job->max = v;
+	}
+	return 0;
+}
+
+/**
+ * Scan a chunk of a text file.
+ * @brief Thread function, reads pairs of numbers from job->begin to job->end.
+ *
+ * @details A pair must not span lines. Its two numbers are separated by blanks, a comma or a
+ * single '-', which is not allowed anywhere else (so no negative numbers). Errors are reported
+ * through job->why, which is NULL on success.
+ *
+ * @param arg the struct parse_job
+ *
+ * @return NULL
+ */
+
+static void *parse_chunk(void *arg){
+	struct parse_job *job = arg;
+	const unsigned char *p = job->begin;
+	const unsigned char *end = job->end;
+	uint64_t first = 0;
+	int have = 0;
+	int dash = 0;
+
+	while(p < end && job->why == NULL){
+		unsigned char c = *p;
+
+		if(c >= '0' && c <= '9'){
+			uint64_t val = 0;
+
+			while(p < end && *p >= '0' && *p <= '9'){
+				val = val*10 + (*p++ - '0');
+				if(val >= UINT32_MAX){
+					job->why = "Vertex number too large.";
+					return NULL;
+				}
+			}
+			if(!have){
+				first = val;
+				have = 1;
+			} else if(first == val){
+				job->why = "No loops allowed";
+			} else if(job_add(job, first, val) == -1){
+				job->why = "Could not allocate any more memory!";
+			} else {
+				have = 0;
+				dash = 0;
+			}
+		} else if(c == '-' && have && !dash){
+			dash = 1;
+			p++;
+		} else if(c == '#' || c == '%'){
+			while(p < end && *p != '\n'){
+				p++;
+			}
+		} else if(c == '\n'){
+			if(have){
+				job->why = "Edge with only one vertex.";
+			}
+			p++;
+		} else if(c == ' ' || c == '\t' || c == '\r' || c == ','){
+			p++;
+		} else {
+			job->why = "Unexpected character in graph file.";
+		}
+	}
+	if(have && job->why == NULL){
+		job->why = "Edge with only one vertex.";
+	}
+	return NULL;
+}
+
+/**
+ * Scan a text file.
+ * @brief Cuts the text at line ends into chunks, scans them in parallel and joins the results.
+ *
+ * @param text the mapped file
+ * @param len its size
+ * @param edges set to the edges, packed as (min << 32) | max, to be freed by the caller
+ * @param count set to the number of edges
+ * @param max set to the largest vertex number
+ * @param why set to an error message if the function fails
+ *
+ * @return 0 on success, -1 on error
+ */
+
+static int parse_text(const unsigned char *text, size_t len, uint64_t **edges, size_t *count,
+	uint32_t *max, const char **why){
+	struct parse_job jobs[PARSE_THREADS_MAX];
+	pthread_t tids[PARSE_THREADS_MAX];
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t chunks = len / PARSE_CHUNK + 1;
+	size_t started = 0;
+
+	if(cpus < 1){
+		cpus = 1;
+	}
+	if(chunks > (size_t)cpus){
+		chunks = cpus;
+	}
+	if(chunks > PARSE_THREADS_MAX){
+		chunks = PARSE_THREADS_MAX;
+	}
+
+	/*Chunk boundaries are moved forward to the next line start.*/
+	const unsigned char *pos = text;
+
+	for(size_t i = 0; i < chunks && pos < text+len; i++){
+		const unsigned char *stop = i+1 == chunks ? text+len : text + (i+1)*(len/chunks);
+
+		if(stop < pos){
+			stop = pos;
+		}
+		while(stop < text+len && stop[-1] != '\n'){
+			stop++;
+		}
+		memset(&jobs[started], 0, sizeof(jobs[started]));
+		jobs[started].begin = pos;
+		jobs[started].end = stop;
+		started++;
+		pos = stop;
+	}
+
+	/*The first chunk is scanned by the calling thread.*/
+	size_t running = 1;
+
+	for(size_t i = 1; i < started; i++){
+		if(pthread_create(&tids[i], NULL, parse_chunk, &jobs[i]) != 0){
+			break;
+		}
+		running++;
+	}
+	for(size_t i = running; i < started; i++){
+		parse_chunk(&jobs[i]);
+	}
+	if(started > 0){
+		parse_chunk(&jobs[0]);
+	}
+	for(size_t i = 1; i < running; i++){
+		pthread_join(tids[i], NULL);
+	}
+
+	size_t total = 0;
+
+	*why = NULL;
+	*max = 0;
+	for(size_t i = 0; i < started; i++){
+		total += jobs[i].count;
+		if(jobs[i].max > *max){
+			*max = jobs[i].max;
+		}
+		if(*why == NULL){
+			*why = jobs[i].why;
+		}
+	}
+
+	/*Join into the first buffer.*/
+	uint64_t *all = NULL;
+
+	if(*why == NULL){
+		all = started > 0 ? realloc(jobs[0].edges, (total > 0 ? total : 1)*sizeof(uint64_t)) :
+			malloc(sizeof(uint64_t));
+		if(all == NULL){
+			*why = "Could not allocate any more memory!";
+		} else {
+			size_t at = started > 0 ? jobs[0].count : 0;
+
+			if(started > 0){
+				jobs[0].edges = NULL;
+			}
+			for(size_t i = 1; i < started; i++){
+				memcpy(all+at, jobs[i].edges, jobs[i].count*sizeof(uint64_t));
+				at += jobs[i].count;
+			}
+		}
+	}
+	for(size_t i = 0; i < started; i++){
+		free(jobs[i].edges);
+	}
+	if(*why != NULL){
+		free(all);
+		return -1;
+	}
+	*edges = all;
+	*count = total;
+	return 0;
+}
+
+/**
+ * Read a binary file.
+ * @brief Checks the size and copies the edges into the packed form.
+ *
+ * @return 0 on success, -1 on error (with a message in why)
+ */
+
+static int parse_binary(const unsigned char *data, size_t len, uint64_t **edges, size_t *count,
+	uint32_t *max, const char **why){
+	uint64_t m;
+
+	memcpy(&m, data+8, sizeof(m));
+	if(m > (len - 16) / 8 || 16 + 8*m != len){
+		*why = "Binary graph file has the wrong size.";
+		return -1;
+	}
+
+	struct parse_job job;
+
+	memset(&job, 0, sizeof(job));
+	job.edges = malloc((m > 0 ? m : 1)*sizeof(uint64_t));
+	job.cap = m;
+	if(job.edges == NULL){
+		*why = "Could not allocate any more memory!";
+		return -1;
+	}
+	for(uint64_t i = 0; i < m; i++){
+		uint32_t pair[2];
+
+		memcpy(pair, data + 16 + 8*i, sizeof(pair));
+		if(pair[0] == pair[1]){
+			free(job.edges);
+			*why = "No loops allowed";
+			return -1;
+		}
+		if(pair[0] == UINT32_MAX || pair[1] == UINT32_MAX){
+			free(job.edges);
+			*why = "Vertex number too large.";
+			return -1;
+		}
+		job_add(&job, pair[0], pair[1]);
+	}
+	*edges = job.edges;
+	*count = job.count;
+	*max = job.max;
+	return 0;
+}
+
+/**
+ * Renumber sparse vertices.
+ * @brief If not every number up to max occurs, the vertices are renumbered densely in increasing
+ * order, which keeps min/max of every edge in place.
+ *
+ * @param edges the edges, rewritten in place
+ * @param count the number of edges
+ * @param max the largest vertex number
+ * @param n set to the number of vertices
+ * @param ids set to the original numbers of the vertices, NULL if nothing was renumbered
+ *
+ * @return 0 on success, -1 if there is not enough memory
+ */
+
+static int remap(uint64_t *edges, size_t count, uint32_t max, unsigned int *n, unsigned int **ids){
+	*ids = NULL;
+	*n = count > 0 ? max+1 : 0;
+	if(count == 0){
+		return 0;
+	}
+
+	if(max < REMAP_TABLE_MAX || max/8 < count){
+		/*Mark, count, and renumber through a table.*/
+		unsigned int *table = calloc((size_t)max+1, sizeof(unsigned int));
+		unsigned int k = 0;
+
+		if(table == NULL){
+			return -1;
+		}
+		for(size_t i = 0; i < count; i++){
+			table[edges[i] >> 32] = 1;
+			table[edges[i] & 0xFFFFFFFFu] = 1;
+		}
+		for(size_t v = 0; v <= max; v++){
+			k += table[v];
+		}
+		if(k == (size_t)max+1){
+			free(table);
+			return 0;
+		}
+
+		*ids = malloc(k*sizeof(unsigned int));
+		if(*ids == NULL){
+			free(table);
+			return -1;
+		}
+		k = 0;
+		for(size_t v = 0; v <= max; v++){
+			if(table[v]){
+				(*ids)[k] = v;
+				table[v] = k++;
+			}
+		}
+		for(size_t i = 0; i < count; i++){
+			edges[i] = ((uint64_t)table[edges[i] >> 32] << 32) | table[edges[i] & 0xFFFFFFFFu];
+		}
+		free(table);
+		*n = k;
+		return 0;
+	}
+
+	/*Very sparse: sort all endpoints and look them up.*/
+	uint64_t *ends = malloc(2*count*sizeof(uint64_t));
+	uint64_t *tmp = malloc(2*count*sizeof(uint64_t));
+
+	if(ends == NULL || tmp == NULL){
+		free(ends);
+		free(tmp);
+		return -1;
+	}
+	for(size_t i = 0; i < count; i++){
+		ends[2*i] = edges[i] >> 32;
+		ends[2*i+1] = edges[i] & 0xFFFFFFFFu;
+	}
+
+	uint64_t *sorted = radix_sort(ends, tmp, 2*count);
+	size_t k = 0;
+
+	for(size_t i = 0; i < 2*count; i++){
+		if(k == 0 || sorted[k-1] != sorted[i]){
+			sorted[k++] = sorted[i];
+		}
+	}
+	*ids = malloc(k*sizeof(unsigned int));
+	if(*ids == NULL){
+		free(ends);
+		free(tmp);
+		return -1;
+	}
+	for(size_t i = 0; i < k; i++){
+		(*ids)[i] = sorted[i];
+	}
+	free(ends);
+	free(tmp);
+
+	for(size_t i = 0; i < count; i++){
+		uint32_t end[2] = {edges[i] >> 32, edges[i] & 0xFFFFFFFFu};
+
+		for(int j = 0; j < 2; j++){
+			size_t lo = 0;
+			size_t hi = k;
+
+			while(lo < hi){
+				size_t mid = (lo + hi) / 2;
+
+				if((*ids)[mid] < end[j]){
+					lo = mid+1;
+				} else {
+					hi = mid;
+				}
+			}
+			end[j] = lo;
+		}
+		edges[i] = ((uint64_t)end[0] << 32) | end[1];
+	}
+	*n = k;
+	return 0;
+}
+
+/**
+ * Build a graph from a file.
+ * @brief Maps the file and reads it as binary edge list if it starts with GRAPH_MAGIC, as text
+ * otherwise. Sparse vertex numbers are renumbered, see above.
+ *
+ * @param g the graph to fill
+ * @param path the file
+ * @param why set to an error message if the function fails
+ *
+ * @return 0 on success, -1 on error
+ */
+
+int graph_from_file(struct graph *g, const char *path, const char **why){
+	int fd = open(path, O_RDONLY);
+	struct stat st;
+	const unsigned char *data;
+	uint64_t *edges = NULL;
+	size_t count = 0;
+	uint32_t max = 0;
+	unsigned int n;
+	unsigned int *ids;
+	int ret;
+
+	memset(g, 0, sizeof(*g));
+	if(fd == -1 || fstat(fd, &st) == -1){
+		if(fd != -1){
+			close(fd);
+		}
+		*why = "Could not open graph file.";
+		return -1;
+	}
+	if(st.st_size == 0){
+		close(fd);
+		*why = "Graph file is empty.";
+		return -1;
+	}
+
+	data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(data == MAP_FAILED){
+		*why = "Could not map graph file.";
+		return -1;
+	}
+	madvise((void *)data, st.st_size, MADV_SEQUENTIAL);
+
+	if((size_t)st.st_size >= 16 && memcmp(data, GRAPH_MAGIC, 8) == 0){
+		ret = parse_binary(data, st.st_size, &edges, &count, &max, why);
+	} else {
+		ret = parse_text(data, st.st_size, &edges, &count, &max, why);
+	}
+	munmap((void *)data, st.st_size);
+	if(ret == -1){
+		return -1;
+	}
+
+	if(remap(edges, count, max, &n, &ids) == -1 || graph_from_edges(g, n, edges, count) == -1){
+		free(edges);
+		free(ids);
+		*why = "Could not allocate any more memory!";
+		return -1;
+	}
+	free(edges);
+	g->ids = ids;
+	return 0;
+}
+
+/**
+ * Size of a stored graph.
+ * @return the number of bytes graph_store() writes for a graph with n vertices and m edges
+ */
+
+size_t graph_bytes(unsigned int n, unsigned int m){
+	return (2*(size_t)m + (size_t)n + 1 + 2*(size_t)m + n)*sizeof(unsigned int);
+}
+
+/**
+ * Store a graph.
+ * @brief Copies all arrays back to back into dst, which must hold graph_bytes(g->n, g->m) bytes.
+ * The original vertex numbers are always stored, for a graph without ids as 0 to n-1.
+ */
+
+void graph_store(const struct graph *g, void *dst){
+	unsigned int *p = dst;
+
+	memcpy(p, g->eu, g->m*sizeof(unsigned int));
+	p += g->m;
+	memcpy(p, g->ev, g->m*sizeof(unsigned int));
+	p += g->m;
+	memcpy(p, g->off, ((size_t)g->n+1)*sizeof(unsigned int));
+	p += g->n+1;
+	memcpy(p, g->adj, 2*(size_t)g->m*sizeof(unsigned int));
+	p += 2*(size_t)g->m;
+	for(unsigned int v = 0; v < g->n; v++){
+		p[v] = graph_id(g, v);
+	}
+}
+
+/**
+ * Use a stored graph.
+ * @brief Points the arrays of g into a block written by graph_store(). Nothing is copied, so the
+ * block must stay mapped as long as g is used, and g must not be passed to graph_free().
+ */
+
+void graph_view(struct graph *g, const void *src, unsigned int n, unsigned int m){
+	unsigned int *p = (unsigned int *)src;
+
+	g->n = n;
+	g->m = m;
+	g->eu = p;
+	g->ev = p + m;
+	g->off = p + 2*(size_t)m;
+	g->adj = p + 2*(size_t)m + n + 1;
+	g->ids = p + 4*(size_t)m + n + 1;
+}
+
+/**
+ * Fingerprint of a graph.
+ * @return an FNV-1a hash of the number of vertices, the sorted edge list and the original vertex
+ * numbers
+ */
+
+uint64_t graph_fingerprint(const struct graph *g){
+	uint64_t h = 0xCBF29CE484222325ull;
+	uint64_t vals[2] = {g->n, g->m};
+
+	for(int i = 0; i < 2; i++){
+		h = (h ^ vals[i]) * 0x100000001B3ull;
+	}
+	for(unsigned int e = 0; e < g->m; e++){
+		h = (h ^ (((uint64_t)g->eu[e] << 32) | g->ev[e])) * 0x100000001B3ull;
+	}
+	if(g->ids != NULL){
+		for(unsigned int v = 0; v < g->n; v++){
+			if(g->ids[v] != v){
+				h = (h ^ (((uint64_t)v << 32) | g->ids[v])) * 0x100000001B3ull;
+			}
+		}
+	}
+	return h;
+}
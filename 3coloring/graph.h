@@ -0,0 +1,60 @@
+/**
+ * @file graph.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Compact graph representation used by the 3-coloring tools.
+ *
+ * @details The graph is built once from the input and never changes afterwards. Every undirected
+ * edge is stored exactly once in the edge arrays (eu[e] < ev[e]), sorted by eu and then ev.
+ * Additionally the neighbors of every vertex are available in CSR form: the neighbors of v are
+ * adj[off[v]] .. adj[off[v+1]-1]. If the input numbered its vertices sparsely, ids[v] is the
+ * number vertex v had in the input (ids is NULL if nothing was renumbered), see graph_id().
+ *
+ * A graph can be stored into one flat block (eu, ev, off, adj and the original vertex numbers back
+ * to back, graph_bytes() in total) and used in place from there with graph_view(). That is how the
+ * supervisor hands the graph to the generators through shared memory. graph_fingerprint()
+ * identifies a graph by its edges and vertex numbers, so two processes can check that they work on
+ * the same one.
+ *
+ */
+
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct graph{
+	unsigned int n;
+	unsigned int m;
+	unsigned int *eu;
+	unsigned int *ev;
+	unsigned int *off;
+	unsigned int *adj;
+	unsigned int *ids;
+};
+
+/*First 8 bytes of a binary graph file.*/
+#define GRAPH_MAGIC "3COLEDGE"
+
+/**
+ * Original vertex number.
+ * @return the number vertex v had in the input
+ */
+
+static inline unsigned int graph_id(const struct graph *g, unsigned int v){
+	return g->ids != NULL ? g->ids[v] : v;
+}
+
+int graph_from_args(struct graph *g, char *args[], int len, const char **why);
+int graph_from_file(struct graph *g, const char *path, const char **why);
+int graph_from_edges(struct graph *g, unsigned int n, uint64_t *edges, size_t count);
+void graph_free(struct graph *g);
+
+size_t graph_bytes(unsigned int n, unsigned int m);
+void graph_store(const struct graph *g, void *dst);
+void graph_view(struct graph *g, const void *src, unsigned int n, unsigned int m);
+uint64_t graph_fingerprint(const struct graph *g);
+
+#endif
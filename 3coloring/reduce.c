@@ -0,0 +1,314 @@
+/**
+ * @file reduce.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief 3-core peeling and biconnected blocks (see reduce.h).
+ *
+ * @details The blocks are found with Tarjan's algorithm on a stack of edges, iteratively so deep
+ * graphs do not overflow the call stack. A block is complete when the search returns from a child
+ * v of p with low[v] >= disc[p]; it consists of the edges pushed since the tree edge (p, v) and p
+ * is the vertex it shares with the blocks found later. Composing the blocks in reverse order
+ * therefore always meets that shared vertex colored already and nothing else of the block.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "reduce.h"
+
+#define NONE UINT_MAX
+
+/**
+ * Remove the vertices of degree below 3.
+ * @brief Removing a vertex lowers the degree of its neighbors, which may then be removed as well.
+ * The removed vertices are appended to r->order in the order they were removed.
+ *
+ * @param r the reduction, order must hold g->n entries
+ * @param removed set to 1 for every removed vertex
+ * @param deg scratch space for the degrees
+ */
+
+static void peel(struct reduction *r, unsigned char *removed, unsigned int *deg){
+	const struct graph *g = r->g;
+	unsigned int head = 0;
+	unsigned int tail = 0;
+
+	for(unsigned int v = 0; v < g->n; v++){
+		deg[v] = g->off[v+1] - g->off[v];
+		if(deg[v] < 3){
+			removed[v] = 1;
+			r->order[tail++] = v;
+		}
+	}
+	while(head < tail){
+		unsigned int v = r->order[head++];
+
+		for(unsigned int i = g->off[v]; i < g->off[v+1]; i++){
+			unsigned int u = g->adj[i];
+
+			if(!removed[u] && --deg[u] < 3){
+				removed[u] = 1;
+				r->order[tail++] = u;
+			}
+		}
+	}
+	r->peeled = tail;
+}
+
+/**
+ * Add a block.
+ * @brief Numbers the vertices of the edges locally, top first, and builds the graph of the block.
+ *
+ * @param r the reduction
+ * @param cap the capacity of r->blocks, grown if needed
+ * @param edges the edges of the block as (u << 32) | v in vertices of the input graph
+ * @param count the number of edges
+ * @param top the vertex shared with the blocks found later
+ * @param local scratch space, NONE for every vertex, left that way
+ *
+ * @return 0 on success, -1 if there is not enough memory
+ */
+
+static int add_block(struct reduction *r, unsigned int *cap, const uint64_t *edges, size_t count,
+	unsigned int top, unsigned int *local){
+	if(r->count == *cap){
+		unsigned int size = *cap > 0 ? 2 * *cap : 16;
+		struct block *tmp = realloc(r->blocks, size*sizeof(struct block));
+
+		if(tmp == NULL){
+			return -1;
+		}
+		r->blocks = tmp;
+		*cap = size;
+	}
+
+	struct block *b = &r->blocks[r->count];
+	uint64_t *packed = malloc(count*sizeof(uint64_t));
+	unsigned int n = 0;
+
+	b->vmap = malloc((count+1)*sizeof(unsigned int));
+	if(packed == NULL || b->vmap == NULL){
+		free(packed);
+		free(b->vmap);
+		return -1;
+	}
+
+	local[top] = n;
+	b->vmap[n++] = top;
+	for(size_t i = 0; i < count; i++){
+		unsigned int end[2] = {edges[i] >> 32, edges[i] & 0xFFFFFFFFu};
+
+		for(int j = 0; j < 2; j++){
+			if(local[end[j]] == NONE){
+				local[end[j]] = n;
+				b->vmap[n++] = end[j];
+			}
+			end[j] = local[end[j]];
+		}
+		packed[i] = end[0] < end[1] ? ((uint64_t)end[0] << 32) | end[1] :
+			((uint64_t)end[1] << 32) | end[0];
+	}
+	for(unsigned int i = 0; i < n; i++){
+		local[b->vmap[i]] = NONE;
+	}
+
+	if(graph_from_edges(&b->g, n, packed, count) == -1){
+		free(packed);
+		free(b->vmap);
+		return -1;
+	}
+	free(packed);
+	r->count++;
+	return 0;
+}
+
+/**
+ * Reduce a graph.
+ * @brief Peels the graph down to its 3-core and splits the core into biconnected blocks.
+ *
+ * @param r the reduction to fill
+ * @param g the graph, must outlive the reduction
+ * @param split 0 if only the peeling is needed, then r has no blocks
+ *
+ * @return 0 on success, -1 if there is not enough memory
+ */
+
+int reduce_init(struct reduction *r, const struct graph *g, int split){
+	size_t n = g->n > 0 ? g->n : 1;
+	unsigned char *removed = calloc(n, 1);
+	unsigned int *disc = calloc(n, sizeof(unsigned int));
+	unsigned int *low = malloc(n*sizeof(unsigned int));
+	unsigned int *parent = malloc(n*sizeof(unsigned int));
+	unsigned int *it = malloc(n*sizeof(unsigned int));
+	unsigned int *stack = malloc(n*sizeof(unsigned int));
+	unsigned int *epos = malloc(n*sizeof(unsigned int));
+	unsigned int *local = malloc(n*sizeof(unsigned int));
+	uint64_t *estack = malloc((g->m > 0 ? g->m : 1)*sizeof(uint64_t));
+	unsigned int cap = 0;
+	unsigned int time = 0;
+	int ret = -1;
+
+	memset(r, 0, sizeof(*r));
+	r->g = g;
+	r->order = malloc(n*sizeof(unsigned int));
+	if(removed == NULL || disc == NULL || low == NULL || parent == NULL || it == NULL ||
+		stack == NULL || epos == NULL || local == NULL || estack == NULL || r->order == NULL){
+		goto out;
+	}
+
+	/*low serves as the degree array while peeling.*/
+	peel(r, removed, low);
+	memset(local, 0xFF, n*sizeof(unsigned int));
+
+	for(unsigned int s = 0; s < g->n && split; s++){
+		if(removed[s] || disc[s] != 0){
+			continue;
+		}
+
+		unsigned int depth = 0;
+		size_t edges = 0;
+
+		disc[s] = low[s] = ++time;
+		parent[s] = NONE;
+		it[s] = g->off[s];
+		stack[depth++] = s;
+
+		while(depth > 0){
+			unsigned int v = stack[depth-1];
+
+			if(it[v] < g->off[v+1]){
+				unsigned int u = g->adj[it[v]++];
+
+				if(removed[u]){
+					continue;
+				}
+				if(disc[u] == 0){
+					epos[u] = edges;
+					estack[edges++] = ((uint64_t)v << 32) | u;
+					disc[u] = low[u] = ++time;
+					parent[u] = v;
+					it[u] = g->off[u];
+					stack[depth++] = u;
+				} else if(u != parent[v] && disc[u] < disc[v]){
+					estack[edges++] = ((uint64_t)v << 32) | u;
+					if(disc[u] < low[v]){
+						low[v] = disc[u];
+					}
+				}
+				continue;
+			}
+
+			unsigned int p = parent[v];
+
+			depth--;
+			if(p == NONE){
+				continue;
+			}
+			if(low[v] < low[p]){
+				low[p] = low[v];
+			}
+			if(low[v] >= disc[p]){
+				if(add_block(r, &cap, estack+epos[v], edges-epos[v], p, local) == -1){
+					goto out;
+				}
+				edges = epos[v];
+			}
+		}
+	}
+	ret = 0;
+
+out:
+	free(removed);
+	free(disc);
+	free(low);
+	free(parent);
+	free(it);
+	free(stack);
+	free(epos);
+	free(local);
+	free(estack);
+	if(ret == -1){
+		reduce_free(r);
+	}
+	return ret;
+}
+
+/**
+ * Free a reduction.
+ */
+
+void reduce_free(struct reduction *r){
+	for(unsigned int b = 0; b < r->count; b++){
+		graph_free(&r->blocks[b].g);
+		free(r->blocks[b].vmap);
+	}
+	free(r->blocks);
+	free(r->order);
+	memset(r, 0, sizeof(*r));
+}
+
+/**
+ * Color the removed vertices.
+ * @brief Colors them in reverse order of removal with the color least used by their colored
+ * neighbors, which is always one none of them has.
+ *
+ * @param r the reduction
+ * @param color one byte per vertex, all vertices of the 3-core colored, all others UNCOLORED
+ */
+
+void reduce_color_peeled(const struct reduction *r, unsigned char *color){
+	const struct graph *g = r->g;
+
+	for(unsigned int i = r->peeled; i > 0; i--){
+		unsigned int v = r->order[i-1];
+		unsigned int used[3] = {0, 0, 0};
+		unsigned int best = 0;
+
+		for(unsigned int j = g->off[v]; j < g->off[v+1]; j++){
+			unsigned int u = g->adj[j];
+
+			if(color[u] != UNCOLORED){
+				used[color[u]]++;
+			}
+		}
+		for(unsigned int c = 1; c < 3; c++){
+			if(used[c] < used[best]){
+				best = c;
+			}
+		}
+		color[v] = best;
+	}
+}
+
+/**
+ * Compose a coloring of the whole graph.
+ * @brief Copies the colorings of the blocks in reverse order, each one with its colors rotated so
+ * its vertex 0 keeps the color it already has, then colors the removed vertices (see
+ * reduce_color_peeled()).
+ *
+ * @param r the reduction
+ * @param colors one color array (colors 0 to 2) per block
+ * @param color the coloring of the whole graph, one byte per vertex
+ */
+
+void reduce_compose(const struct reduction *r, unsigned char *const *colors, unsigned char *color){
+	const struct graph *g = r->g;
+
+	memset(color, UNCOLORED, g->n);
+	for(unsigned int b = r->count; b > 0; b--){
+		const struct block *blk = &r->blocks[b-1];
+		const unsigned char *c = colors[b-1];
+		unsigned int shift = 0;
+
+		if(color[blk->vmap[0]] != UNCOLORED){
+			shift = (color[blk->vmap[0]] + 3 - c[0]) % 3;
+		}
+		for(unsigned int i = 0; i < blk->g.n; i++){
+			color[blk->vmap[i]] = (c[i] + shift) % 3;
+		}
+	}
+
+	reduce_color_peeled(r, color);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file reduce.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Shrinking the graph before the search.
+ *
+ * @details A vertex with fewer than three neighbors can always get a color none of its neighbors
+ * has, so it never needs to be part of a conflicting edge. reduce_init() removes such vertices
+ * until none is left (the 3-core remains) and cuts the rest into biconnected blocks. Two blocks
+ * share at most one vertex, and renaming the colors of a block does not change its conflicts, so
+ * the blocks can be searched on their own: the conflicts of the whole graph are the sum of the
+ * conflicts of the blocks.
+ *
+ * reduce_compose() turns one coloring per block back into a coloring of the whole graph with
+ * exactly that many conflicts. The removed vertices are colored greedily in reverse order of
+ * removal.
+ *
+ */
+
+#ifndef REDUCE_H
+#define REDUCE_H
+
+#include "graph.h"
+
+/*One biconnected block of the 3-core. vmap[i] is the vertex of the input graph that is vertex i
+of the block, vertex 0 is the one the block shares with the blocks composed before it.*/
+struct block{
+	struct graph g;
+	unsigned int *vmap;
+};
+
+struct reduction{
+	const struct graph *g;
+	unsigned int count;
+	struct block *blocks;
+	unsigned int peeled;
+	unsigned int *order;
+};
+
+/*Marks a vertex without color in the color arrays of reduce_color_peeled().*/
+#define UNCOLORED 0xFF
+
+int reduce_init(struct reduction *r, const struct graph *g, int split);
+void reduce_free(struct reduction *r);
+void reduce_compose(const struct reduction *r, unsigned char *const *colors, unsigned char *color);
+void reduce_color_peeled(const struct reduction *r, unsigned char *color);
+
+#endif
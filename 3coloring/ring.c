@@ -0,0 +1,787 @@
+/**
+ * @file ring.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Lock-free multi-producer single-consumer ring with futex wait (see ring.h).
+ *
+ * @details The sleep protocol is the same on both sides: read the event counter, announce the
+ * sleeper, check the condition again and only then wait for the counter to change. The other side
+ * first publishes its change, then increments the counter and only then looks for sleepers. With
+ * sequentially consistent ordering of these steps one of the two always sees the other, so no
+ * wakeup is lost, and FUTEX_WAIT returns at once if the counter moved in between.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "ring.h"
+
+/**
+ * Deadline.
+ * @brief Sets end to ms milliseconds from now on the monotonic clock.
+ */
+
+static void deadline(struct timespec *end, unsigned int ms){
+	clock_gettime(CLOCK_MONOTONIC, end);
+	end->tv_sec += ms / 1000;
+	end->tv_nsec += ms % 1000 * 1000000L;
+	if(end->tv_nsec >= 1000000000){
+		end->tv_sec++;
+		end->tv_nsec -= 1000000000;
+	}
+}
+
+/**
+ * Time left until a deadline.
+ * @return 1 and the time in left if end has not passed yet, 0 otherwise
+ */
+
+static int time_left(const struct timespec *end, struct timespec *left){
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	left->tv_sec = end->tv_sec - now.tv_sec;
+	left->tv_nsec = end->tv_nsec - now.tv_nsec;
+	if(left->tv_nsec < 0){
+		left->tv_sec--;
+		left->tv_nsec += 1000000000;
+	}
+	return left->tv_sec >= 0;
+}
+
+/**
+ * Sleep on a futex.
+ * @brief Returns at once if *addr is not val anymore, spurious wakeups are fine for the callers.
+ * timeout is relative, NULL waits for a wakeup.
+ */
+
+static void futex_wait(uint32_t *addr, uint32_t val, const struct timespec *timeout){
+	syscall(SYS_futex, addr, FUTEX_WAIT, val, timeout, NULL, 0);
+}
+
+/**
+ * Wake everybody sleeping on a futex.
+ */
+
+static void futex_wake(uint32_t *addr){
+	syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+/**
+ * Address of a slot.
+ * @brief Slots follow the header, slotBytes apart.
+ */
+
+static struct slot *slot_at(const struct circ *c, uint32_t pos){
+	size_t header = (sizeof(struct circ) + RING_ALIGN-1) & ~(size_t)(RING_ALIGN-1);
+
+	return (struct slot *)((char *)c + header + (size_t)(pos & (c->capacity-1))*c->slotBytes);
+}
+
+/**
+ * Name of the segment of a job.
+ * @brief The default job keeps the name the segment always had, "/sharedspace".
+ *
+ * @param name set to the name, RING_NAME_MAX bytes
+ * @param job the job name: 1 to RING_JOB_MAX letters, digits, '_', '-' or '.', not starting with
+ * '.'
+ *
+ * @return 0 on success, -1 if the job name is not allowed
+ */
+
+int ring_name(char *name, const char *job){
+	size_t len = strlen(job);
+
+	if(len == 0 || len > RING_JOB_MAX || job[0] == '.'){
+		return -1;
+	}
+	for(size_t i = 0; i < len; i++){
+		if(!isalnum((unsigned char)job[i]) && job[i] != '_' && job[i] != '-' && job[i] != '.'){
+			return -1;
+		}
+	}
+	if(strcmp(job, RING_JOB) == 0){
+		snprintf(name, RING_NAME_MAX, "/%s", job);
+	} else {
+		snprintf(name, RING_NAME_MAX, "/3coloring.%s", job);
+	}
+	return 0;
+}
+
+/**
+ * Own a segment.
+ * @brief Takes an exclusive lock on the shared memory, which the kernel drops when the owner
+ * exits, however it exits. The descriptor has to stay open as long as the owner runs.
+ *
+ * @param fd descriptor of the shared memory
+ *
+ * @return 0 on success, -1 if somebody else owns it
+ */
+
+int ring_own(int fd){
+	return flock(fd, LOCK_EX | LOCK_NB);
+}
+
+/**
+ * Check for a dead owner.
+ * @brief Only looks at the fields that never change, so it also works on segments of other
+ * versions.
+ *
+ * @param c the mapped header
+ * @param fd descriptor of the shared memory
+ *
+ * @return 1 if the segment was never finished or nobody owns it (see ring_own()) anymore, 0
+ * otherwise
+ */
+
+int ring_orphaned(const struct circ *c, int fd){
+	if(c->magic != RING_MAGIC || c->owner <= 0){
+		return 1;
+	}
+	if(flock(fd, LOCK_SH | LOCK_NB) == -1){
+		return 0;
+	}
+	flock(fd, LOCK_UN);
+	return 1;
+}
+
+/**
+ * Smallest slot.
+ * @return the size of a slot that holds records with up to maxEdges edges and a coloring of
+ * colorWords words, rounded up to RING_ALIGN
+ */
+
+size_t ring_slot_bytes(uint32_t maxEdges, uint32_t colorWords){
+	size_t bytes = sizeof(struct slot) + (1 + 2*(size_t)maxEdges + colorWords)*sizeof(uint32_t);
+
+	return (bytes + RING_ALIGN-1) & ~(size_t)(RING_ALIGN-1);
+}
+
+/**
+ * Size of an elite entry.
+ * @return the size of an entry of the elite pool, rounded up to RING_ALIGN
+ */
+
+size_t ring_elite_bytes(uint32_t colorWords){
+	size_t bytes = sizeof(struct elite) + (size_t)colorWords*sizeof(uint32_t);
+
+	return (bytes + RING_ALIGN-1) & ~(size_t)(RING_ALIGN-1);
+}
+
+/**
+ * Size of the segment.
+ * @return the number of bytes of a ring with the given layout, elite pool included
+ */
+
+size_t ring_size(uint32_t capacity, uint32_t slotBytes, uint32_t eliteSlots, uint32_t colorWords){
+	size_t header = (sizeof(struct circ) + RING_ALIGN-1) & ~(size_t)(RING_ALIGN-1);
+
+	return header + (size_t)capacity*slotBytes + (size_t)eliteSlots*ring_elite_bytes(colorWords);
+}
+
+/**
+ * Address of an elite entry.
+ * @brief The pool follows the slots.
+ */
+
+static struct elite *elite_at(const struct circ *c, uint32_t i){
+	size_t offset = ring_size(c->capacity, c->slotBytes, 0, 0) + i*ring_elite_bytes(c->colorWords);
+
+	return (struct elite *)((char *)c + offset);
+}
+
+/**
+ * Initialize the ring.
+ * @brief Called by the supervisor before any generator attaches. The segment must be
+ * ring_size(capacity, slotBytes, eliteSlots, colorWords) bytes large.
+ *
+ * @param c the ring in shared memory
+ * @param capacity the number of slots, a power of two
+ * @param slotBytes the size of a slot, a multiple of RING_ALIGN and at least
+ * ring_slot_bytes(maxEdges, colorWords)
+ * @param maxEdges the largest number of edges of a record
+ * @param colorWords the size of the coloring in a record, 0 if records carry none
+ * @param eliteSlots the number of entries of the elite pool, 0 if colorWords is 0
+ */
+
+void ring_init(struct circ *c, uint32_t capacity, uint32_t slotBytes, uint32_t maxEdges,
+	uint32_t colorWords, uint32_t eliteSlots){
+	memset(c, 0, sizeof(*c));
+	c->magic = RING_MAGIC;
+	c->version = RING_VERSION;
+	c->size = ring_size(capacity, slotBytes, eliteSlots, colorWords);
+	c->owner = getpid();
+	c->capacity = capacity;
+	c->slotBytes = slotBytes;
+	c->maxEdges = maxEdges;
+	c->colorWords = colorWords;
+	c->eliteSlots = eliteSlots;
+	c->edgeCount = maxEdges + 1;
+	for(uint32_t i = 0; i < capacity; i++){
+		slot_at(c, i)->seq = i;
+	}
+	for(uint32_t i = 0; i < eliteSlots; i++){
+		elite_at(c, i)->seq = 0;
+	}
+	for(unsigned int i = 0; i < RING_ARMS; i++){
+		c->arms[i].share = RING_SHARE_SCALE / RING_ARMS;
+	}
+}
+
+/**
+ * Check the header.
+ * @brief Used by the generators before they trust anything in the segment.
+ *
+ * @param c the mapped segment
+ * @param mapped how many bytes of it are mapped
+ *
+ * @return 0 if the segment holds a ring of this version that fits into the mapping (and so does
+ * the graph, if there is one), -1 otherwise
+ */
+
+int ring_check(const struct circ *c, size_t mapped){
+	if(mapped < sizeof(*c) || c->magic != RING_MAGIC || c->version != RING_VERSION){
+		return -1;
+	}
+	if(c->capacity == 0 || (c->capacity & (c->capacity-1)) != 0 ||
+		c->slotBytes < ring_slot_bytes(c->maxEdges, c->colorWords) ||
+		(c->eliteSlots > 0 && c->colorWords == 0) ||
+		c->size < ring_size(c->capacity, c->slotBytes, c->eliteSlots, c->colorWords) ||
+		c->size > mapped){
+		return -1;
+	}
+	if(c->graphBytes > 0 && (c->graphOffset < ring_size(c->capacity, c->slotBytes, c->eliteSlots,
+		c->colorWords) ||
+		c->graphOffset > c->size || c->graphBytes > c->size - c->graphOffset)){
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * Claim a new best solution.
+ * @brief Lowers edgeCount to the given value if that is an improvement.
+ *
+ * @details Only the generator whose compare-and-swap succeeds sends its solution, so the ring only
+ * ever carries strictly improving solutions and nobody has to lock for the check.
+ *
+ * @return the number of edges the best solution was lowered by if the solution is the new best
+ * and should be pushed, 0 otherwise
+ */
+
+unsigned int ring_claim_best(struct circ *c, unsigned int edgeCount){
+	unsigned int cur = __atomic_load_n(&c->edgeCount, __ATOMIC_RELAXED);
+
+	while(edgeCount < cur){
+		if(__atomic_compare_exchange_n(&c->edgeCount, &cur, edgeCount, 0, __ATOMIC_ACQ_REL,
+			__ATOMIC_RELAXED)){
+			return cur - edgeCount;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Current best.
+ * @return the number of edges of the best solution claimed so far
+ */
+
+unsigned int ring_best(const struct circ *c){
+	return __atomic_load_n(&c->edgeCount, __ATOMIC_RELAXED);
+}
+
+/**
+ * Reserve a slot.
+ * @brief Reserves the next position for a record. Sleeps while the ring is full, and asks stop
+ * every RING_STOP_POLL_MS whether to give up: a producer whose process stops on its own, or whose
+ * consumer is gone, would otherwise sleep until somebody terminates the ring.
+ *
+ * @param c the ring
+ * @param pos set to the reserved position, to be passed to ring_commit()
+ * @param stop returns nonzero once the producer should give up, may be NULL
+ *
+ * @return where to write the record, NULL if the ring has been terminated or stop said so
+ */
+
+uint32_t *ring_reserve(struct circ *c, uint32_t *pos, int (*stop)()){
+	uint32_t p = __atomic_load_n(&c->head, __ATOMIC_RELAXED);
+	struct timespec poll = {RING_STOP_POLL_MS / 1000, RING_STOP_POLL_MS % 1000 * 1000000L};
+
+	while(!ring_terminated(c)){
+		struct slot *s = slot_at(c, p);
+		uint32_t seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE);
+		int32_t dif = (int32_t)(seq - p);
+
+		if(dif == 0){
+			if(__atomic_compare_exchange_n(&c->head, &p, p+1, 1, __ATOMIC_RELAXED,
+				__ATOMIC_RELAXED)){
+				*pos = p;
+				return s->record;
+			}
+			continue;
+		}
+
+		if(dif < 0){
+			/*Full: the slot still holds the record from one round ago.*/
+			uint32_t ev = __atomic_load_n(&c->spaces, __ATOMIC_SEQ_CST);
+
+			if(stop != NULL && stop()){
+				return NULL;
+			}
+			__atomic_fetch_add(&c->producersWaiting, 1, __ATOMIC_SEQ_CST);
+			if(__atomic_load_n(&s->seq, __ATOMIC_SEQ_CST) == seq && !ring_terminated(c)){
+				futex_wait(&c->spaces, ev, stop != NULL ? &poll : NULL);
+			}
+			__atomic_fetch_sub(&c->producersWaiting, 1, __ATOMIC_SEQ_CST);
+		}
+		p = __atomic_load_n(&c->head, __ATOMIC_RELAXED);
+	}
+	return NULL;
+}
+
+/**
+ * Hand a record to the consumer.
+ * @brief Must follow every successful ring_reserve(), the consumer waits for the position.
+ */
+
+void ring_commit(struct circ *c, uint32_t pos){
+	__atomic_store_n(&slot_at(c, pos)->seq, pos+1, __ATOMIC_RELEASE);
+
+	__atomic_fetch_add(&c->items, 1, __ATOMIC_SEQ_CST);
+	if(__atomic_load_n(&c->consumerWaiting, __ATOMIC_SEQ_CST)){
+		futex_wake(&c->items);
+	}
+}
+
+/**
+ * Look at the oldest record.
+ * @brief Sleeps while the ring is empty. Only one process may consume.
+ *
+ * @return the record, valid until ring_release(), NULL if the ring has been terminated or the
+ * best solution has been proven optimal, and is empty
+ */
+
+const uint32_t *ring_peek(struct circ *c){
+	uint32_t pos = c->tail;
+	struct slot *s = slot_at(c, pos);
+
+	while(__atomic_load_n(&s->seq, __ATOMIC_ACQUIRE) != pos+1){
+		if(ring_terminated(c) || ring_proven(c)){
+			return NULL;
+		}
+
+		uint32_t ev = __atomic_load_n(&c->items, __ATOMIC_SEQ_CST);
+
+		__atomic_store_n(&c->consumerWaiting, 1, __ATOMIC_SEQ_CST);
+		if(__atomic_load_n(&s->seq, __ATOMIC_SEQ_CST) != pos+1 && !ring_terminated(c) &&
+			!ring_proven(c)){
+			futex_wait(&c->items, ev, NULL);
+		}
+		__atomic_store_n(&c->consumerWaiting, 0, __ATOMIC_SEQ_CST);
+	}
+	return s->record;
+}
+
+/**
+ * Wait for a record.
+ * @brief Used by the supervisor once the best solution has been proven optimal, when ring_peek()
+ * does not sleep anymore but the record of the best solution may still be on its way. The
+ * generator that claimed it may also have died before committing it.
+ *
+ * @param c the ring
+ * @param ms how long to wait at most
+ *
+ * @return 0 once the oldest slot holds a record or the ring is terminated, -1 after ms
+ * milliseconds without
+ */
+
+int ring_await(struct circ *c, unsigned int ms){
+	struct slot *s = slot_at(c, c->tail);
+	struct timespec end;
+	struct timespec left;
+
+	deadline(&end, ms);
+	while(__atomic_load_n(&s->seq, __ATOMIC_ACQUIRE) != c->tail+1 && !ring_terminated(c)){
+		uint32_t ev = __atomic_load_n(&c->items, __ATOMIC_SEQ_CST);
+
+		if(!time_left(&end, &left)){
+			return -1;
+		}
+		__atomic_store_n(&c->consumerWaiting, 1, __ATOMIC_SEQ_CST);
+		if(__atomic_load_n(&s->seq, __ATOMIC_SEQ_CST) != c->tail+1 && !ring_terminated(c)){
+			futex_wait(&c->items, ev, &left);
+		}
+		__atomic_store_n(&c->consumerWaiting, 0, __ATOMIC_SEQ_CST);
+	}
+	return 0;
+}
+
+/**
+ * Free the oldest record.
+ * @brief Gives the slot returned by ring_peek() back to the producers.
+ */
+
+void ring_release(struct circ *c){
+	uint32_t pos = c->tail;
+
+	__atomic_store_n(&slot_at(c, pos)->seq, pos+c->capacity, __ATOMIC_RELEASE);
+	c->tail = pos+1;
+
+	__atomic_fetch_add(&c->spaces, 1, __ATOMIC_SEQ_CST);
+	if(__atomic_load_n(&c->producersWaiting, __ATOMIC_SEQ_CST)){
+		futex_wake(&c->spaces);
+	}
+}
+
+/**
+ * Terminate.
+ * @brief Sets the termination flag and wakes up everybody who sleeps on the ring. Only uses
+ * async-signal-safe calls, so the supervisor may call it from its signal handler.
+ */
+
+void ring_terminate(struct circ *c){
+	__atomic_store_n(&c->termination, 1, __ATOMIC_SEQ_CST);
+	__atomic_fetch_add(&c->epoch, 1, __ATOMIC_SEQ_CST);
+	__atomic_fetch_add(&c->items, 1, __ATOMIC_SEQ_CST);
+	__atomic_fetch_add(&c->spaces, 1, __ATOMIC_SEQ_CST);
+	futex_wake(&c->items);
+	futex_wake(&c->spaces);
+}
+
+/**
+ * Termination check.
+ * @return 1 if the ring has been terminated
+ */
+
+int ring_terminated(const struct circ *c){
+	return __atomic_load_n(&c->termination, __ATOMIC_RELAXED) == 1;
+}
+
+/**
+ * Monotonic clock.
+ * @return milliseconds of CLOCK_MONOTONIC, the time base of the subtree leases
+ */
+
+static uint64_t now_ms(){
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec*1000 + now.tv_nsec/1000000;
+}
+
+/**
+ * Lease a subtree of the exact search.
+ * @brief Takes the next subtree nobody has leased yet. Once there is none, takes a subtree whose
+ * lease ran out, its generator is gone.
+ *
+ * @param c the ring
+ * @param subtrees the number of subtrees of the search tree, at most RING_SUBTREES
+ * @param lease set to the value of the lease, see ring_renew_subtree()
+ *
+ * @return the number of the subtree, RING_SUBTREE_BUSY if all subtrees that are not done are
+ * leased, subtrees if all are done
+ */
+
+uint64_t ring_claim_subtree(struct circ *c, uint64_t subtrees, uint64_t *lease){
+	uint64_t now = now_ms();
+	uint64_t next = __atomic_load_n(&c->subtreeNext, __ATOMIC_RELAXED);
+	int pending = 0;
+
+	*lease = now + RING_LEASE_MS;
+	if(next < subtrees){
+		next = __atomic_fetch_add(&c->subtreeNext, 1, __ATOMIC_RELAXED);
+
+		uint64_t free = 0;
+
+		if(next < subtrees && __atomic_compare_exchange_n(&c->subtreeLease[next], &free, *lease,
+			0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)){
+			return next;
+		}
+	}
+
+	/*Free entries are taken as well, a generator may have died between taking the number and
+	leasing it.*/
+	for(uint64_t i = 0; i < subtrees; i++){
+		uint64_t old = __atomic_load_n(&c->subtreeLease[i], __ATOMIC_ACQUIRE);
+
+		if(old == RING_SUBTREE_DONE){
+			continue;
+		}
+		pending = 1;
+		if((old == 0 || old < now) && __atomic_compare_exchange_n(&c->subtreeLease[i], &old,
+			*lease, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)){
+			return i;
+		}
+	}
+	return pending ? RING_SUBTREE_BUSY : subtrees;
+}
+
+/**
+ * Renew the lease of a subtree.
+ * @brief Called while the subtree is searched, at least every RING_LEASE_MS.
+ *
+ * @param c the ring
+ * @param subtree the subtree
+ * @param lease the value of the lease, set to the new one
+ *
+ * @return 0 on success, -1 if the lease ran out and somebody else took the subtree (the search can
+ * go on, the subtree is only counted once)
+ */
+
+int ring_renew_subtree(struct circ *c, uint64_t subtree, uint64_t *lease){
+	uint64_t renewed = now_ms() + RING_LEASE_MS;
+
+	if(!__atomic_compare_exchange_n(&c->subtreeLease[subtree], lease, renewed, 0,
+		__ATOMIC_ACQ_REL, __ATOMIC_RELAXED)){
+		return -1;
+	}
+	*lease = renewed;
+	return 0;
+}
+
+/**
+ * Report a searched subtree.
+ * @brief Marks a subtree that has been searched to the end and counts it, once even if its lease
+ * ran out and it was searched twice. The thread completing the last one proves the best solution
+ * optimal (see ring_prove()).
+ *
+ * @param c the ring
+ * @param subtree the subtree
+ * @param subtrees the number of subtrees of the search tree
+ */
+
+void ring_subtree_done(struct circ *c, uint64_t subtree, uint64_t subtrees){
+	if(__atomic_exchange_n(&c->subtreeLease[subtree], RING_SUBTREE_DONE, __ATOMIC_ACQ_REL) ==
+		RING_SUBTREE_DONE){
+		return;
+	}
+	if(__atomic_add_fetch(&c->subtreeDone, 1, __ATOMIC_ACQ_REL) == subtrees){
+		ring_prove(c);
+	}
+}
+
+/**
+ * Mark the best solution optimal.
+ * @brief Sets the proven flag and wakes the supervisor like a push does. Called once no coloring
+ * can beat ring_best() anymore, by the exact search or by the supervisor's lower bound.
+ */
+
+void ring_prove(struct circ *c){
+	__atomic_store_n(&c->proven, 1, __ATOMIC_SEQ_CST);
+	__atomic_fetch_add(&c->epoch, 1, __ATOMIC_SEQ_CST);
+	__atomic_fetch_add(&c->items, 1, __ATOMIC_SEQ_CST);
+	futex_wake(&c->items);
+}
+
+/**
+ * Optimality check.
+ * @return 1 if all subtrees of the exact search have been searched, so no coloring has fewer
+ * conflicting edges than ring_best()
+ */
+
+int ring_proven(const struct circ *c){
+	return __atomic_load_n(&c->proven, __ATOMIC_ACQUIRE) == 1;
+}
+
+/**
+ * Cancellation epoch.
+ * @return the current epoch, see ring.h
+ */
+
+uint32_t ring_epoch(const struct circ *c){
+	return __atomic_load_n(&c->epoch, __ATOMIC_RELAXED);
+}
+
+/**
+ * Announce a generator.
+ * @brief Called once the generator has mapped the segment.
+ */
+
+void ring_attach(struct circ *c){
+	__atomic_fetch_add(&c->attached, 1, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * Withdraw a generator.
+ * @brief Called before the generator unmaps the segment, wakes the supervisor if it was the last.
+ */
+
+void ring_detach(struct circ *c){
+	if(__atomic_sub_fetch(&c->attached, 1, __ATOMIC_SEQ_CST) == 0){
+		futex_wake(&c->attached);
+	}
+}
+
+/**
+ * Wait for the generators to leave.
+ * @brief Called by the supervisor before it removes the segment.
+ *
+ * @param c the ring
+ * @param ms how long to wait at most, generators that crashed never detach
+ *
+ * @return 0 once no generator is attached, -1 if some still were after ms milliseconds
+ */
+
+int ring_wait_detached(struct circ *c, unsigned int ms){
+	struct timespec end;
+	struct timespec left;
+
+	deadline(&end, ms);
+	while(1){
+		uint32_t attached = __atomic_load_n(&c->attached, __ATOMIC_SEQ_CST);
+
+		if(attached == 0){
+			return 0;
+		}
+		if(!time_left(&end, &left)){
+			return -1;
+		}
+		futex_wait(&c->attached, attached, &left);
+	}
+}
+
+/**
+ * Write an entry of the elite pool.
+ * @brief Only called by the supervisor, which decides which entry a coloring replaces.
+ *
+ * @param c the ring
+ * @param i the entry, at most eliteFilled (eliteFilled grows if it is equal)
+ * @param words the coloring, colorWords words
+ * @param conflicts its number of conflicting edges
+ */
+
+void ring_elite_put(struct circ *c, uint32_t i, const uint32_t *words, unsigned int conflicts){
+	if(i >= c->eliteSlots || i > c->eliteFilled){
+		return;
+	}
+
+	struct elite *e = elite_at(c, i);
+	uint32_t seq = e->seq;
+
+	__atomic_store_n(&e->seq, seq+1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	e->conflicts = conflicts;
+	memcpy(e->words, words, (size_t)c->colorWords*sizeof(uint32_t));
+	__atomic_store_n(&e->seq, seq+2, __ATOMIC_RELEASE);
+
+	if(i == c->eliteFilled){
+		__atomic_store_n(&c->eliteFilled, c->eliteFilled + 1, __ATOMIC_RELEASE);
+	}
+}
+
+/**
+ * Copy a coloring from the elite pool.
+ * @brief Retries a few times while the supervisor is rewriting the entry.
+ *
+ * @param c the ring
+ * @param i the entry, below eliteFilled
+ * @param words set to the coloring, colorWords words
+ *
+ * @return the number of conflicting edges of the coloring, -1 if no consistent copy was made
+ */
+
+int ring_elite_get(const struct circ *c, uint32_t i, uint32_t *words){
+	const struct elite *e = elite_at(c, i);
+
+	for(int tries = 0; tries < 4; tries++){
+		uint32_t before = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+
+		if(before & 1){
+			continue;
+		}
+
+		unsigned int conflicts = e->conflicts;
+
+		memcpy(words, e->words, (size_t)c->colorWords*sizeof(uint32_t));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if(__atomic_load_n(&e->seq, __ATOMIC_RELAXED) == before){
+			return conflicts;
+		}
+	}
+	return -1;
+}
+
+/**
+ * Pick a strategy of the portfolio.
+ * @brief Picks every strategy with a probability proportional to its share.
+ *
+ * @param c the ring
+ * @param u a random number in [0, 1)
+ *
+ * @return the strategy, RING_ARM_MINCONF if no strategy has a share
+ */
+
+unsigned int ring_arm_pick(const struct circ *c, double u){
+	uint32_t shares[RING_ARMS];
+	uint32_t total = 0;
+
+	for(unsigned int i = 0; i < RING_ARMS; i++){
+		shares[i] = __atomic_load_n(&c->arms[i].share, __ATOMIC_RELAXED);
+		total += shares[i];
+	}
+	if(total == 0){
+		return RING_ARM_MINCONF;
+	}
+
+	uint32_t x = (uint32_t)(u*total);
+
+	for(unsigned int i = 0; i < RING_ARMS; i++){
+		if(x < shares[i]){
+			return i;
+		}
+		x -= shares[i];
+	}
+	return RING_ARMS-1;
+}
+
+/**
+ * Account a turn of the portfolio.
+ *
+ * @param c the ring
+ * @param arm the strategy the turn ran
+ * @param ms the length of the turn in milliseconds
+ * @param gain the edges the solutions of the turn took off the best solution
+ */
+
+void ring_arm_account(struct circ *c, unsigned int arm, uint64_t ms, uint64_t gain){
+	__atomic_fetch_add(&c->arms[arm].turns, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&c->arms[arm].ms, ms, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&c->arms[arm].gain, gain, __ATOMIC_RELAXED);
+}
+
+/**
+ * Statistics of a strategy of the portfolio.
+ *
+ * @param c the ring
+ * @param arm the strategy
+ * @param out set to its turns, milliseconds, gain and share
+ */
+
+void ring_arm_read(const struct circ *c, unsigned int arm, struct arm *out){
+	out->turns = __atomic_load_n(&c->arms[arm].turns, __ATOMIC_RELAXED);
+	out->ms = __atomic_load_n(&c->arms[arm].ms, __ATOMIC_RELAXED);
+	out->gain = __atomic_load_n(&c->arms[arm].gain, __ATOMIC_RELAXED);
+	out->share = __atomic_load_n(&c->arms[arm].share, __ATOMIC_RELAXED);
+}
+
+/**
+ * Set the shares of the portfolio.
+ * @brief Only called by the supervisor.
+ *
+ * @param c the ring
+ * @param shares RING_ARMS shares, in RING_SHARE_SCALE parts
+ */
+
+void ring_arm_set(struct circ *c, const uint32_t *shares){
+	for(unsigned int i = 0; i < RING_ARMS; i++){
+		__atomic_store_n(&c->arms[i].share, shares[i], __ATOMIC_RELAXED);
+	}
+}
@@ -0,0 +1,207 @@
+/**
+ * @file ring.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief The circular buffer in shared memory between the generators and the supervisor.
+ *
+ * @details Lock-free ring with many producers (generator threads) and one consumer (the
+ * supervisor). Every slot has a sequence number: slot i is free for the producer that reserved
+ * position p (p % capacity == i) if seq == p, and holds a record for the consumer if
+ * seq == p + 1. Producers reserve positions with a compare-and-swap on head, so they never wait
+ * for each other, only for a full ring.
+ *
+ * Nobody spins: a consumer finding the ring empty (a producer finding it full) sleeps on a futex
+ * on the items (spaces) event counter, which the other side increments after every push (pop).
+ * The futex is only woken if someone announced that it sleeps, so in the common case a push or
+ * pop is a handful of atomic instructions and no system call.
+ *
+ * A slot holds one binary record: the number of edges k followed by k (u, v) pairs, so 1 + 2k
+ * uint32_t in total. If colorWords is not 0, the record ends with the coloring that produced the
+ * edges, colorWords uint32_t as written by coloring_pack(). A record starting with RING_OFFSPRING
+ * instead is a candidate for the elite pool that needs not beat the best solution: its number of
+ * conflicting edges follows, then the coloring. Producers write the record straight into the slot
+ * between ring_reserve() and ring_commit(), the consumer reads it in place between ring_peek() and
+ * ring_release(). Text is only made by the supervisor when it prints.
+ *
+ * The supervisor chooses the layout at runtime: capacity (number of slots, a power of two),
+ * slotBytes (size of a slot including its sequence number, a multiple of RING_ALIGN so two slots
+ * never share a cache line) and maxEdges (largest record). The segment starts with struct circ,
+ * whose first fields (magic, version, size, owner) never change, so a generator can map just the
+ * header, check that it speaks the same protocol and then map size bytes.
+ *
+ * Every job has its own segment, named after its job name (ring_name()), so several jobs can run
+ * on one host. The supervisor that created a segment holds a lock on it (ring_own()) and writes
+ * its process id to owner. A segment nobody holds the lock of was left behind by a crashed
+ * supervisor and may be replaced, generators notice it with ring_orphaned().
+ *
+ * Behind the slots lies the elite pool: eliteSlots entries (struct elite, ring_elite_bytes() each)
+ * with good colorings the supervisor has received and their number of conflicting edges. It is
+ * also the population of the evolutionary strategy. Only the supervisor writes it and decides which
+ * entry a coloring replaces, eliteFilled says how many are valid. Every entry is a sequence lock:
+ * seq is odd while the supervisor rewrites it, so a generator copying an entry can tell that it
+ * read a torn coloring and retry. The pool needs colorWords, so it only exists if the supervisor
+ * has the graph.
+ *
+ * If the supervisor was given the graph, it is stored behind the ring (see graph_store()) at
+ * graphOffset, a multiple of the page size, so generators can map that part read-only. graphBytes
+ * is 0 if there is no graph in the segment.
+ *
+ * edgeCount is the best solution any generator has claimed so far and only ever decreases. It
+ * starts at maxEdges + 1, so every claimed solution fits into a slot.
+ *
+ * The exact strategy splits its search tree into subtrees numbered from 0. A generator thread
+ * leases a subtree (ring_claim_subtree()): subtreeLease holds 0 while a subtree is free,
+ * RING_SUBTREE_DONE once it has been searched to the end and otherwise the time its lease runs out,
+ * in milliseconds of CLOCK_MONOTONIC, which is the same for every process of the host. The thread
+ * renews the lease while it searches (ring_renew_subtree()), so the lease of a generator that was
+ * killed or crashed runs out after RING_LEASE_MS and the subtree is handed out again. subtreeNext
+ * is the next subtree nobody has leased yet, subtreeDone counts the subtrees searched to the end.
+ * Once all are done, no coloring beats edgeCount and proven is set: the best claimed solution is
+ * optimal and the supervisor can stop. The supervisor sets it as well once edgeCount meets its
+ * lower bound.
+ *
+ * arms is the control block of the strategy portfolio (generators started with -s auto). Their
+ * threads play turns: every turn runs one strategy, picked at random in proportion to its share
+ * (ring_arm_pick()), and afterwards adds its length and the edges its solutions took off edgeCount
+ * to the statistics of that strategy (ring_arm_account()). The supervisor reads the statistics and
+ * sets the shares (ring_arm_set()), in RING_SHARE_SCALE parts.
+ *
+ * epoch is the cancellation epoch: ring_terminate() and ring_prove() increment it, after either
+ * nothing a generator is doing can improve the result. A generator remembers the epoch it started
+ * in and its searches poll it every few thousand operations, a single load. attached counts the
+ * generators that have the segment mapped (ring_attach(), ring_detach()), so the supervisor can
+ * wait for all of them to leave (ring_wait_detached()) before it removes the segment.
+ *
+ */
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RING_MAGIC 0x4C4F4333u
+#define RING_VERSION 11
+
+/*Defaults of the supervisor.*/
+#define RING_CAPACITY 64
+#define RING_MAX_EDGES 1024
+#define RING_ELITES 8
+
+/*First word of an offspring record, never a number of edges.*/
+#define RING_OFFSPRING 0xFFFFFFFFu
+
+#define RING_ALIGN 64
+
+/*Job names: the default, the longest one and the size of a segment name made from one.*/
+#define RING_JOB "sharedspace"
+#define RING_JOB_MAX 64
+#define RING_NAME_MAX (RING_JOB_MAX + 16)
+
+/*Strategies of the portfolio, indices into arms.*/
+#define RING_ARM_SLICED 0
+#define RING_ARM_MINCONF 1
+#define RING_ARM_ANNEAL 2
+#define RING_ARM_EVOLVE 3
+#define RING_ARMS 4
+
+#define RING_SHARE_SCALE 1000
+
+/*How often a producer waiting on a full ring asks whether it should give up, in milliseconds.*/
+#define RING_STOP_POLL_MS 100
+
+/*Most subtrees of the exact search (3^8), the lease of a subtree and the value of a subtree searched
+to the end. ring_claim_subtree() returns RING_SUBTREE_BUSY if all subtrees not done yet are
+leased.*/
+#define RING_SUBTREES 6561
+#define RING_LEASE_MS 5000
+#define RING_SUBTREE_DONE UINT64_MAX
+#define RING_SUBTREE_BUSY UINT64_MAX
+
+struct slot{
+	uint32_t seq;
+	uint32_t record[];
+};
+
+struct elite{
+	uint32_t seq;
+	uint32_t conflicts;
+	uint32_t words[];
+};
+
+struct arm{
+	uint64_t turns;
+	uint64_t ms;
+	uint64_t gain;
+	uint32_t share;
+};
+
+struct circ{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t size;
+	int32_t owner;
+	uint32_t capacity;
+	uint32_t slotBytes;
+	uint32_t maxEdges;
+	uint32_t colorWords;
+	uint32_t eliteSlots;
+	uint32_t eliteFilled;
+	uint32_t graphN;
+	uint32_t graphM;
+	uint64_t graphOffset;
+	uint64_t graphBytes;
+	uint64_t graphHash;
+	unsigned int edgeCount;
+	unsigned int termination;
+	unsigned int proven;
+	uint32_t epoch;
+	uint32_t attached;
+	uint64_t subtreeNext;
+	uint64_t subtreeDone;
+	uint64_t subtreeLease[RING_SUBTREES];
+	struct arm arms[RING_ARMS];
+	uint32_t head __attribute__((aligned(RING_ALIGN)));
+	uint32_t producersWaiting;
+	uint32_t spaces;
+	uint32_t tail __attribute__((aligned(RING_ALIGN)));
+	uint32_t consumerWaiting;
+	uint32_t items;
+};
+
+int ring_name(char *name, const char *job);
+int ring_own(int fd);
+int ring_orphaned(const struct circ *c, int fd);
+size_t ring_slot_bytes(uint32_t maxEdges, uint32_t colorWords);
+size_t ring_elite_bytes(uint32_t colorWords);
+size_t ring_size(uint32_t capacity, uint32_t slotBytes, uint32_t eliteSlots, uint32_t colorWords);
+void ring_init(struct circ *c, uint32_t capacity, uint32_t slotBytes, uint32_t maxEdges,
+	uint32_t colorWords, uint32_t eliteSlots);
+int ring_check(const struct circ *c, size_t mapped);
+unsigned int ring_claim_best(struct circ *c, unsigned int edgeCount);
+uint32_t *ring_reserve(struct circ *c, uint32_t *pos, int (*stop)());
+void ring_commit(struct circ *c, uint32_t pos);
+const uint32_t *ring_peek(struct circ *c);
+int ring_await(struct circ *c, unsigned int ms);
+void ring_release(struct circ *c);
+void ring_terminate(struct circ *c);
+int ring_terminated(const struct circ *c);
+unsigned int ring_best(const struct circ *c);
+uint64_t ring_claim_subtree(struct circ *c, uint64_t subtrees, uint64_t *lease);
+int ring_renew_subtree(struct circ *c, uint64_t subtree, uint64_t *lease);
+void ring_subtree_done(struct circ *c, uint64_t subtree, uint64_t subtrees);
+void ring_prove(struct circ *c);
+int ring_proven(const struct circ *c);
+uint32_t ring_epoch(const struct circ *c);
+void ring_attach(struct circ *c);
+void ring_detach(struct circ *c);
+int ring_wait_detached(struct circ *c, unsigned int ms);
+void ring_elite_put(struct circ *c, uint32_t i, const uint32_t *words, unsigned int conflicts);
+int ring_elite_get(const struct circ *c, uint32_t i, uint32_t *words);
+unsigned int ring_arm_pick(const struct circ *c, double u);
+void ring_arm_account(struct circ *c, unsigned int arm, uint64_t ms, uint64_t gain);
+void ring_arm_read(const struct circ *c, unsigned int arm, struct arm *out);
+void ring_arm_set(struct circ *c, const uint32_t *shares);
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * @file rng.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Seeding and stream splitting for the xoshiro256** generator (see rng.h).
+ *
+ */
+
+#include "rng.h"
+
+/**
+ * splitmix64 step.
+ * @brief Used to turn one 64 bit seed into the 256 bit state, also for seeds like 0 or 1.
+ */
+
+static uint64_t splitmix64(uint64_t *x){
+	uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+/**
+ * Seed a generator.
+ * @brief The same seed always gives the same sequence.
+ */
+
+void rng_seed(struct rng *r, uint64_t seed){
+	for(int i = 0; i < 4; i++){
+		r->s[i] = splitmix64(&seed);
+	}
+	r->pool = 0;
+	r->left = 0;
+}
+
+/**
+ * Jump ahead.
+ * @brief Advances the generator by 2^128 draws, equivalent to that many rng_next() calls.
+ */
+
+void rng_jump(struct rng *r){
+	static const uint64_t jump[] = {
+		0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+	};
+	uint64_t s[4] = {0, 0, 0, 0};
+
+	for(int i = 0; i < 4; i++){
+		for(int b = 0; b < 64; b++){
+			if(jump[i] & (1ull << b)){
+				for(int j = 0; j < 4; j++){
+					s[j] ^= r->s[j];
+				}
+			}
+			rng_next(r);
+		}
+	}
+	for(int j = 0; j < 4; j++){
+		r->s[j] = s[j];
+	}
+	r->pool = 0;
+	r->left = 0;
+}
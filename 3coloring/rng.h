@@ -0,0 +1,105 @@
+/**
+ * @file rng.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Per-worker pseudo random numbers (xoshiro256**).
+ *
+ * @details Every worker owns a struct rng, so drawing numbers needs no shared state and no lock.
+ * rng_seed() expands a 64 bit seed with splitmix64, rng_jump() advances a generator by 2^128 draws,
+ * which gives every worker of a process its own non-overlapping stream from the same seed.
+ *
+ * The drawing functions are inline, they sit in the innermost loops of the searches. None of them
+ * uses a modulo: colors come from a pool of 2-bit chunks of one 64 bit draw with the value 3
+ * rejected, bounded numbers use a multiply-shift with rejection of the biased low range.
+ *
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+struct rng{
+	uint64_t s[4];
+	uint64_t pool;
+	unsigned int left;
+};
+
+void rng_seed(struct rng *r, uint64_t seed);
+void rng_jump(struct rng *r);
+
+static inline uint64_t rng_rotl(uint64_t x, int k){
+	return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * 64 random bits.
+ * @return the next output of xoshiro256**
+ */
+
+static inline uint64_t rng_next(struct rng *r){
+	uint64_t *s = r->s;
+	uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+	uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rng_rotl(s[3], 45);
+	return result;
+}
+
+/**
+ * Random color.
+ * @brief Takes 2 bits at a time from one 64 bit draw (32 candidates per draw) and rejects 3.
+ * @return 0, 1 or 2, uniformly
+ */
+
+static inline unsigned int rng_color(struct rng *r){
+	for(;;){
+		if(r->left == 0){
+			r->pool = rng_next(r);
+			r->left = 32;
+		}
+
+		unsigned int c = r->pool & 3;
+
+		r->pool >>= 2;
+		r->left--;
+		if(c != 3){
+			return c;
+		}
+	}
+}
+
+/**
+ * Random number below a bound.
+ * @return a uniform number in [0, bound), bound must not be 0
+ */
+
+static inline uint32_t rng_below(struct rng *r, uint32_t bound){
+	uint64_t m = (rng_next(r) >> 32) * bound;
+
+	if((uint32_t)m < bound){
+		uint32_t threshold = -bound % bound;
+
+		while((uint32_t)m < threshold){
+			m = (rng_next(r) >> 32) * bound;
+		}
+	}
+	return m >> 32;
+}
+
+/**
+ * Random probability.
+ * @return a uniform number in [0, 1) with 53 random bits
+ */
+
+static inline double rng_unit(struct rng *r){
+	return (rng_next(r) >> 11) * 0x1.0p-53;
+}
+
+#endif
@@ -0,0 +1,285 @@
+/**
+ * @file search.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Local search strategies for the generator.
+ *
+ * @details Min-conflicts search: starting from the coloring search_start() gives, every move
+ * recolors a vertex that is part of a conflicting edge, taking the vertex and color that remove the
+ * most conflicting edges (ties are broken randomly). Going back to a color a vertex just left is
+ * tabu for a while, unless that would give a new best coloring, so the search does not cycle
+ * between the same few colorings. If the best coloring of a run has not improved for a long time,
+ * the search restarts from a new coloring.
+ *
+ * Simulated annealing: a random conflicting vertex gets a random other color. Moves that do not
+ * add conflicts are always taken, a move that adds d conflicts with probability exp(-d/T). The
+ * temperature T starts at w->temp and is multiplied by w->cooling every w->steps moves. Once it
+ * drops below ANNEAL_FROZEN the schedule starts over from the current coloring. Every schedule
+ * runs at least one temperature, so a start temperature below ANNEAL_FROZEN means greedy moves at
+ * that temperature.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "search.h"
+#include "conflict.h"
+
+/*Tabu tenure: a random part below TABU_BASE plus TABU_FACTOR times the number of conflicting
+edges.*/
+#define TABU_BASE 10
+#define TABU_FACTOR 0.6
+
+/*A run restarts after STALL_BASE + STALL_PER_VERTEX * |V| moves without improvement.*/
+#define STALL_BASE 10000
+#define STALL_PER_VERTEX 10
+
+/*Annealing: default moves per temperature per vertex, and the temperature below which the
+schedule starts over at the start temperature.*/
+#define ANNEAL_STEPS_PER_VERTEX 10
+#define ANNEAL_FROZEN 0.01
+
+/*How often a long running loop checks for termination.*/
+#define STOP_CHECK 1024
+
+/**
+ * Allocate zeroed memory.
+ * @brief calloc() that never asks for zero bytes, so NULL always means out of memory.
+ */
+
+static void *alloc(size_t n, size_t size){
+	return calloc(n > 0 ? n : 1, size);
+}
+
+/**
+ * One min-conflicts run.
+ * @brief Starts from the coloring in cs and moves until no conflict is left, the run has not
+ * improved for its stall limit or the generator has to stop. Every coloring that beats the bound is
+ * reported.
+ *
+ * @details The neighbor color counts of conflict.h give the effect of every move in O(1), so
+ * finding the best non-tabu move costs one look at each conflicting vertex and doing it O(degree).
+ *
+ * @param w the worker
+ * @param cs the state, assigned the start coloring
+ * @param tabu the tabu list, 3 entries per vertex
+ * @param best if not NULL, set to the best coloring of the run
+ *
+ * @return the number of conflicting edges of the best coloring of the run
+ */
+
+static unsigned int tabu_run(struct worker *w, struct conflicts *cs, unsigned long *tabu,
+	unsigned char *best){
+	const struct graph *g = w->g;
+	unsigned long stall = STALL_BASE + STALL_PER_VERTEX*(unsigned long)g->n;
+	unsigned long iter = 0;
+	unsigned long lastImprove = 0;
+	unsigned long work = 0;
+	unsigned int runBest = cs->total;
+
+	memset(tabu, 0, 3*(size_t)g->n*sizeof(unsigned long));
+	if(best != NULL){
+		memcpy(best, cs->color, g->n);
+	}
+	if(cs->total < search_bound(w)){
+		search_report(w, cs->color, cs->total);
+	}
+
+	while(cs->total > 0 && iter-lastImprove < stall){
+		if(iter % STOP_CHECK == 0 && search_stopped(w)){
+			break;
+		}
+		/*A move looks at every conflicting vertex, which can be most of a large graph.*/
+		work += cs->size;
+		if(work >= SEARCH_CANCEL_WORK){
+			work = 0;
+			if(search_cancelled(w)){
+				break;
+			}
+		}
+		iter++;
+
+		/*Best allowed move of a conflicting vertex, ties are broken randomly.*/
+		int bestDelta = 0;
+		unsigned int bestVertex = 0;
+		int bestColor = -1;
+		unsigned int ties = 0;
+
+		for(unsigned int i = 0; i < cs->size; i++){
+			unsigned int v = cs->set[i];
+
+			for(unsigned int c = 0; c < 3; c++){
+				if(c == cs->color[v]){
+					continue;
+				}
+				int delta = conflict_delta(cs, v, c);
+
+				if(tabu[3*(size_t)v+c] > iter && (int)cs->total+delta >= (int)runBest){
+					continue;
+				}
+				if(bestColor == -1 || delta < bestDelta){
+					bestVertex = v;
+					bestColor = c;
+					bestDelta = delta;
+					ties = 1;
+				} else if(delta == bestDelta && rng_below(&w->rng, ++ties) == 0){
+					bestVertex = v;
+					bestColor = c;
+				}
+			}
+		}
+		if(bestColor == -1){
+			continue;
+		}
+
+		unsigned int old = cs->color[bestVertex];
+
+		conflict_move(cs, bestVertex, bestColor);
+		tabu[3*(size_t)bestVertex+old] = iter + rng_below(&w->rng, TABU_BASE) +
+			(unsigned long)(TABU_FACTOR*cs->total);
+
+		if(cs->total < runBest){
+			runBest = cs->total;
+			lastImprove = iter;
+			if(best != NULL){
+				memcpy(best, cs->color, g->n);
+			}
+			if(cs->total < search_bound(w)){
+				search_report(w, cs->color, cs->total);
+			}
+		}
+	}
+	return runBest;
+}
+
+/**
+ * Min-conflicts search with tabu list.
+ * @brief Runs min-conflicts runs (see tabu_run()) from new start colorings until the generator has
+ * to stop.
+ *
+ * @param w the worker
+ *
+ * @return 0 once the generator has to stop, -1 if there is not enough memory
+ */
+
+int search_minconf(struct worker *w){
+	const struct graph *g = w->g;
+	struct conflicts cs;
+	unsigned char *color = alloc(g->n, 1);
+	unsigned long *tabu = alloc(3*(size_t)g->n, sizeof(unsigned long));
+
+	if(color == NULL || tabu == NULL || conflict_init(&cs, g) == -1){
+		free(color);
+		free(tabu);
+		return -1;
+	}
+
+	while(!search_stopped(w)){
+		search_start(w, color);
+		conflict_assign(&cs, color);
+		tabu_run(w, &cs, tabu, NULL);
+	}
+
+	conflict_free(&cs);
+	free(color);
+	free(tabu);
+	return 0;
+}
+
+/**
+ * Improve a coloring.
+ * @brief One min-conflicts run from the given coloring, used on the offspring of the evolutionary
+ * strategy.
+ *
+ * @param w the worker
+ * @param color the start coloring, replaced by the best coloring of the run
+ *
+ * @return the number of conflicting edges of the new coloring, -1 if there is not enough memory
+ */
+
+int search_improve(struct worker *w, unsigned char *color){
+	const struct graph *g = w->g;
+	struct conflicts cs;
+	unsigned long *tabu = alloc(3*(size_t)g->n, sizeof(unsigned long));
+
+	if(tabu == NULL || conflict_init(&cs, g) == -1){
+		free(tabu);
+		return -1;
+	}
+	conflict_assign(&cs, color);
+
+	unsigned int conflicts = tabu_run(w, &cs, tabu, color);
+
+	conflict_free(&cs);
+	free(tabu);
+	return conflicts;
+}
+
+/**
+ * Simulated annealing.
+ * @brief Runs the annealing schedule of the worker until the generator has to stop.
+ *
+ * @details Picking the vertex from the conflict set and evaluating the move are O(1), doing it is
+ * O(degree). Only colorings that beat the best of the current schedule are reported.
+ *
+ * @param w the worker, temp, cooling and steps must be set
+ *
+ * @return 0 once the generator has to stop, -1 if there is not enough memory
+ */
+
+int search_anneal(struct worker *w){
+	const struct graph *g = w->g;
+	struct conflicts cs;
+	unsigned char *color = alloc(g->n, 1);
+	unsigned long steps = w->steps > 0 ? w->steps : ANNEAL_STEPS_PER_VERTEX*(unsigned long)g->n;
+	unsigned long iter = 0;
+
+	if(color == NULL || conflict_init(&cs, g) == -1){
+		free(color);
+		return -1;
+	}
+
+	search_start(w, color);
+	conflict_assign(&cs, color);
+	if(cs.total < search_bound(w)){
+		search_report(w, cs.color, cs.total);
+	}
+
+	while(cs.total > 0 && !search_stopped(w)){
+		unsigned int runBest = cs.total;
+		double t = w->temp;
+
+		/*At least one level, also if the start temperature is already below ANNEAL_FROZEN.*/
+		do{
+			for(unsigned long i = 0; i < steps && cs.total > 0; i++){
+				if(++iter % STOP_CHECK == 0 && search_stopped(w)){
+					goto out;
+				}
+
+				unsigned int v = cs.set[rng_below(&w->rng, cs.size)];
+				unsigned int c = (cs.color[v] + 1 + rng_below(&w->rng, 2)) % 3;
+				int delta = conflict_delta(&cs, v, c);
+
+				if(delta > 0 && rng_unit(&w->rng) >= exp(-delta/t)){
+					continue;
+				}
+				conflict_move(&cs, v, c);
+
+				if(cs.total < runBest){
+					runBest = cs.total;
+					if(cs.total < search_bound(w)){
+						search_report(w, cs.color, cs.total);
+					}
+				}
+			}
+			t *= w->cooling;
+		} while(t >= ANNEAL_FROZEN && cs.total > 0);
+	}
+
+out:
+	conflict_free(&cs);
+	free(color);
+	return 0;
+}
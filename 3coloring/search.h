@@ -0,0 +1,62 @@
+/**
+ * @file search.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Search strategies of the generator that work on single vertices.
+ *
+ * @details A strategy runs until the supervisor asks the generators to stop. It works on a plain
+ * color array (one byte per vertex, colors 0 to 2) and hands every coloring that beats the current
+ * best of the supervisor to search_report(). Every run starts from the coloring search_start()
+ * gives. The search_* hooks are implemented by the generator, they connect the strategies to the
+ * shared memory. search_exact() (exact.c) also shares its search tree with the other generators
+ * through search_claim() and search_done(), search_evolve() (evolve.c) breeds from the elite pool
+ * through search_parents() and search_offspring(). A strategy only knows w->g, which may also be
+ * one block of a reduced graph (see reduce.h), the hooks then measure and stop the search per
+ * block.
+ *
+ */
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "graph.h"
+#include "coloring.h"
+
+/*State of one search worker. temp, cooling and steps are the annealing schedule: start
+temperature, factor applied after every steps moves (0 means a default depending on |V|). hooks
+belongs to the generator's search_* hooks.*/
+struct worker{
+	const struct graph *g;
+	struct rng rng;
+	double temp;
+	double cooling;
+	unsigned long steps;
+	struct coloring out;
+	void *hooks;
+};
+
+int search_minconf(struct worker *w);
+int search_anneal(struct worker *w);
+int search_exact(struct worker *w);
+int search_evolve(struct worker *w);
+int search_improve(struct worker *w, unsigned char *color);
+
+/*A search calls search_cancelled() whenever it has done about SEARCH_CANCEL_WORK elementary
+operations (move evaluations, vertices looked at), so it gives up its CPU soon after the supervisor
+shuts down, however long a single step takes. search_stopped() may read the clock and is called
+less often.*/
+#define SEARCH_CANCEL_WORK 4096
+
+/*Provided by the generator.*/
+int search_stopped(struct worker *w);
+int search_cancelled(struct worker *w);
+unsigned int search_bound(struct worker *w);
+void search_report(struct worker *w, const unsigned char *color, unsigned int conflicts);
+void search_start(struct worker *w, unsigned char *color);
+uint64_t search_claim(struct worker *w, uint64_t subtrees);
+void search_done(struct worker *w, uint64_t subtree, uint64_t subtrees);
+int search_parents(struct worker *w, unsigned char *a, unsigned char *b);
+void search_offspring(struct worker *w, const unsigned char *color, unsigned int conflicts);
+
+#endif
@@ -8,6 +8,23 @@
  * order to make a given graph 3-colorable. These solutions are stored in a circular buffer. The
  * supervisor remembers the best solution. If a solution without any edges has been sent to the
  * supervisor the supervisor shuts down the generators. 
+ * It does the same once exact generators have proven the best solution optimal (see ring.h), or
+ * once the best solution meets the lower bound the supervisor computes from the graph (see
+ * bound.h): a first one before the search and better ones in a background thread during it.
+ * The colorings of the best solutions are kept in the elite pool of the shared memory, where the
+ * generators pick them up to restart their searches from. The pool is also the population of the
+ * evolutionary generators, whose offspring the supervisor selects from, see poolOffer().
+ * Generators started with -s auto let the supervisor choose their strategies: a background thread
+ * watches how fast each strategy lowers the best solution per core-second and moves the turns of
+ * the portfolio towards the best one, see schedulePortfolio().
+ * With -j the supervisor starts the generators itself, pins them to CPUs, restarts crashed ones
+ * and reaps all of them when it stops (see fleet.h).
+ * Every job has its own shared memory, named after the job name given with -J (see ring_name()),
+ * so several jobs can run side by side. Shared memory a crashed supervisor of the same job left
+ * behind is detected and replaced, see createSegment().
+ * On shutdown the generators stop within milliseconds, they poll the cancellation epoch of the
+ * shared memory (see ring.h). The supervisor removes the segment only once all of them have
+ * detached from it, or DETACH_GRACE_MS have passed.
  *
  */
 
@@ -21,41 +38,110 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/types.h>
-#include <semaphore.h>
 #include <signal.h>
+#include <pthread.h>
+#include <time.h>
+#include <math.h>
+#include "ring.h"
+#include "graph.h"
+#include "bound.h"
+#include "coloring.h"
+#include "fleet.h"
+
+
+/*The bound thread gives up after this many packings in a row without improvement.*/
+#define BOUND_ROUNDS 200
+
+/*Colorings of the pool that differ in fewer than 1/POOL_DISTANCE of the vertices (see
+coloring_distance()) count as the same.*/
+#define POOL_DISTANCE 20
+
+/*The portfolio thread sets the shares every PORTFOLIO_PERIOD_MS. Statistics lose weight by
+PORTFOLIO_DECAY per period, every strategy keeps PORTFOLIO_FLOOR (of RING_SHARE_SCALE) and
+PORTFOLIO_EXPLORE weighs the exploration term of the confidence bound.*/
+#define PORTFOLIO_PERIOD_MS 250
+#define PORTFOLIO_DECAY 0.97
+#define PORTFOLIO_FLOOR 50
+#define PORTFOLIO_EXPLORE 0.5
+
+/*How long the supervisor waits for the record of the best solution once it has been proven
+optimal. The generator that claimed it may have died before sending it.*/
+#define RECORD_GRACE_MS 1000
+
+/*How long the supervisor waits for the generators to detach before it removes the shared memory.
+Generators that crashed never detach.*/
+#define DETACH_GRACE_MS 1000
 
-#define EDGE_MAX 8
-#define CIRC_BUF_LEN 40
-#define SEM_1 "/sem_1"
-#define SEM_2 "/sem_2"
-#define MTEX "/sem_3"
-#define SHM_NAME "/sharedspace"
-
-
-struct circ{
-	unsigned int edgeCount;
-	unsigned int write_pos;
-	unsigned int read_pos;
-	unsigned int termination;
-	char solutions[CIRC_BUF_LEN][100];
+struct circ *circ_buf;
+size_t circ_size;
+
+/*Name of the shared memory of the job.*/
+static char shmName[RING_NAME_MAX];
+
+/*Lower bound on the edges to remove, raised by the bound thread.*/
+static struct packing packing;
+static unsigned int lowerBound;
+static pthread_t boundThread;
+static int boundRunning;
+static volatile int boundStop;
+
+/*Copy of the elite pool: the colorings and their conflicting edges, poolFilled are valid.*/
+static uint32_t *poolWords;
+static unsigned int *poolConflicts;
+static unsigned int poolFilled;
+static unsigned int poolSlots;
+static unsigned int poolWordsPer;
+static unsigned int poolN;
+
+/*The generators started with -j.*/
+static struct fleet fleet;
+
+/*The strategies of the generator, see its -s.*/
+static const char *const strategies[] = {
+	"random", "sliced", "minconf", "anneal", "exact", "evolve", "auto"
 };
 
-struct circ *circ_buf;
-sem_t *free_sem, *used_sem, *mtex_sem;
+static pthread_t portfolioThread;
+static int portfolioRunning;
+static volatile int portfolioStop;
 
 static void usage();
 static void cleanup();
 static void err_msg(char *msg);
 static void signal_handler(int signal);
+static void printSolution(const uint32_t *record);
+static void *improveBound(void *arg);
+static void stopBound();
+static void poolOffer(const uint32_t *words, unsigned int conflicts);
+static void *schedulePortfolio(void *arg);
+static void printPortfolio();
+static void startFleet(unsigned long count, char *strategy, char *job);
+static void fleetEnded();
+static int knownStrategy(const char *strategy);
+static int createSegment(const char *job);
+static int sameSegment(int fd);
+static unsigned long parseNumber(const char *str, unsigned long min, unsigned long max);
 
 char *prog_name; 
 
 /**
  * Program entry point. 
- * @brief The program starts here. The synopis is very simple. The supervisor must be called without
- * any arguments or options. 
+ * @brief The program starts here. Options set the layout of the ring: -c number of slots (rounded
+ * up to a power of two, default RING_CAPACITY), -m largest number of edges of a solution (default
+ * RING_MAX_EDGES), -s bytes per slot (default: just enough for -m) and -e number of colorings in
+ * the elite pool (default RING_ELITES, 0 turns the pool off). See ring.h.
+ *
+ * The graph can be given as edges on the command line like for the generator, or with -f file. It
+ * is then built once here and published read-only in the shared memory, and the generators can be
+ * started without arguments.
+ *
+ * -j N starts N generators from the directory of the supervisor, 0 means one per available CPU
+ * (see fleet_cpus()). They run the strategy given with -g, default auto. -j needs the graph. Once
+ * all of them have ended without being told to, the supervisor shuts down.
  *
- * @details The shared memory is created directly here. 
+ * -J names the job (default RING_JOB), generators of the job have to be started with the same -J.
+ *
+ * @details The shared memory is created directly here, sized for the chosen layout and the graph.
  *
  * @param argv The argument vector.
  * @param argc The argument counter.
@@ -64,96 +150,259 @@ char *prog_name;
 
 int main (int argc, char *argv[]){
 	prog_name = argv[0];
-	
-	if(argc > 1){
+
+	unsigned long capacity = RING_CAPACITY;
+	unsigned long maxEdges = RING_MAX_EDGES;
+	unsigned long slotBytes = 0;
+	unsigned long elites = RING_ELITES;
+	long jobs = -1;
+	char *strategy = "auto";
+	char *job = RING_JOB;
+	const char *file = NULL;
+	int c;
+
+	while((c = getopt(argc, argv, "c:m:s:f:e:j:g:J:")) != -1){
+		switch(c){
+			case 'c':
+				capacity = parseNumber(optarg, 2, 1ul << 20);
+				break;
+			case 'm':
+				maxEdges = parseNumber(optarg, 1, 1ul << 24);
+				break;
+			case 's':
+				slotBytes = parseNumber(optarg, 1, 1ul << 30);
+				break;
+			case 'f':
+				file = optarg;
+				break;
+			case 'e':
+				elites = parseNumber(optarg, 0, 1024);
+				break;
+			case 'j':
+				jobs = parseNumber(optarg, 0, FLEET_MAX);
+				break;
+			case 'g':
+				strategy = optarg;
+				break;
+			case 'J':
+				job = optarg;
+				break;
+			default:
+				usage();
+		}
+	}
+	if(file != NULL && optind < argc){
 		usage();
 	}
+	if(ring_name(shmName, job) == -1){
+		err_msg("Job names are letters, digits, '_', '-' and '.', at most 64 of them.");
+	}
+	if(jobs >= 0 && file == NULL && optind == argc){
+		err_msg("-j needs the graph, give it with -f file or as edges.");
+	}
+	if(!knownStrategy(strategy)){
+		err_msg("Unknown strategy, use random, sliced, minconf, anneal, exact, evolve or auto.");
+	}
+	if(jobs >= 0 && strcmp(strategy, "evolve") == 0 && elites < 2){
+		err_msg("The evolve strategy needs at least 2 elites.");
+	}
 
-	if(signal(SIGINT,signal_handler) == SIG_ERR){
-		printf("\nProblem with SIGINT.\n");
+	struct graph graph;
+	const char *why = NULL;
+	int haveGraph = file != NULL || optind < argc;
+
+	memset(&graph, 0, sizeof(graph));
+	if(file != NULL && graph_from_file(&graph, file, &why) == -1){
+		err_msg((char *)why);
 	}
-	if(signal(SIGTERM,signal_handler) == SIG_ERR){
-		printf("\nProblem with SIGTERM.\n");
+	if(file == NULL && optind < argc && graph_from_args(&graph, argv+optind, argc-optind, &why) == -1){
+		err_msg((char *)why);
 	}
 
+	while((capacity & (capacity-1)) != 0){
+		capacity += capacity & -capacity;
+	}
+	/*Records carry colorings for the elite pool only if the generators know the graph.*/
+	unsigned long colorWords = haveGraph && elites > 0 ? COLORING_WORDS(graph.n) : 0;
 
-	/*Create Shared Memory*/
-	int fd = shm_open(SHM_NAME,O_RDWR | O_CREAT,0600);
-	
-	if(fd == -1){
-		close(fd);
-		shm_unlink(SHM_NAME);
-		err_msg("Could not allocate memory.\n");
+	if(colorWords == 0){
+		elites = 0;
 	}
+	if(slotBytes == 0){
+		slotBytes = ring_slot_bytes(maxEdges, colorWords);
+	}
+	slotBytes = (slotBytes + RING_ALIGN-1) & ~(unsigned long)(RING_ALIGN-1);
+	if(slotBytes < ring_slot_bytes(maxEdges, colorWords)){
+		err_msg("Slot size too small for the maximum number of edges.");
+	}
+	circ_size = ring_size(capacity, slotBytes, elites, colorWords);
+
+	if(elites > 0){
+		poolWords = malloc(elites*colorWords*sizeof(uint32_t));
+		poolConflicts = malloc(elites*sizeof(unsigned int));
+		if(poolWords == NULL || poolConflicts == NULL){
+			err_msg("Could not allocate any more memory!");
+		}
+		poolSlots = elites;
+		poolWordsPer = colorWords;
+		poolN = graph.n;
+	}
+
+	/*The graph starts on its own page, so it can be mapped read-only.*/
+	size_t page = sysconf(_SC_PAGESIZE);
+	size_t graphOffset = (circ_size + page-1) / page * page;
+	size_t graphBytes = haveGraph ? graph_bytes(graph.n, graph.m) : 0;
 
-	if(ftruncate(fd,CIRC_BUF_LEN) < 0){
+	if(haveGraph){
+		circ_size = graphOffset + graphBytes;
+	}
+
+	/*Create Shared Memory*/
+	int fd = createSegment(job);
+
+	if(ftruncate(fd,circ_size) < 0){
 		close(fd);
-		shm_unlink(SHM_NAME);
+		shm_unlink(shmName);
 		err_msg("Problem with setting size of allocated memory.");
 	}
 
-	circ_buf = mmap(NULL, sizeof(*circ_buf), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);	
+	circ_buf = mmap(NULL, circ_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
 
 	if(circ_buf == MAP_FAILED){
 		close(fd);
-		shm_unlink(SHM_NAME);
+		shm_unlink(shmName);
 		err_msg("Could not map memory.");
 	}
 
-	circ_buf->write_pos = 0;
-	circ_buf->read_pos = 0;
-	circ_buf->edgeCount = EDGE_MAX; 
-	circ_buf->termination = 0;
+	ring_init(circ_buf, capacity, slotBytes, maxEdges, colorWords, elites);
 
-	if(close(fd) == -1){
-		munmap(circ_buf,sizeof(*circ_buf));
-		shm_unlink(SHM_NAME);
-		err_msg("Could not close file descriptor!");
+	/*The handler terminates the ring, so it is installed once there is one.*/
+	if(signal(SIGINT,signal_handler) == SIG_ERR){
+		printf("\nProblem with SIGINT.\n");
 	}
+	if(signal(SIGTERM,signal_handler) == SIG_ERR){
+		printf("\nProblem with SIGTERM.\n");
+	}
+	if(haveGraph){
+		circ_buf->size = circ_size;
+		circ_buf->graphN = graph.n;
+		circ_buf->graphM = graph.m;
+		circ_buf->graphOffset = graphOffset;
+		circ_buf->graphBytes = graphBytes;
+		circ_buf->graphHash = graph_fingerprint(&graph);
+		graph_store(&graph, (char *)circ_buf + graphOffset);
+		mprotect((char *)circ_buf + graphOffset, graphBytes, PROT_READ);
+	}
+
+	/*fd stays open, it holds the lock that tells the job is running (see ring_own()).*/
+
+	/*Signals are handled by the main thread.*/
+	sigset_t block;
+	sigset_t old;
 
-	/*Create Semaphore*/
-	free_sem = sem_open(SEM_1, O_CREAT | O_EXCL, 0600, 1);
-	used_sem = sem_open(SEM_2, O_CREAT | O_EXCL, 0600, 0);
-	mtex_sem = sem_open(MTEX, O_CREAT | O_EXCL, 0600,1);
+	sigemptyset(&block);
+	sigaddset(&block, SIGINT);
+	sigaddset(&block, SIGTERM);
 
-	if(free_sem == SEM_FAILED || used_sem == SEM_FAILED){
-		err_msg("Could not create Semaphores.");
+	/*First bound in the plain order, then shuffled ones in the background.*/
+	if(haveGraph && bound_init(&packing, &graph, getpid()) == 0){
+		lowerBound = bound_pack(&packing, 0, &boundStop);
+		if(lowerBound > 0){
+			printf("Lower bound: %u edges.\n", lowerBound);
+		}
+
+		pthread_sigmask(SIG_BLOCK, &block, &old);
+		boundRunning = pthread_create(&boundThread, NULL, improveBound, NULL) == 0;
+		pthread_sigmask(SIG_SETMASK, &old, NULL);
+	}
+
+	pthread_sigmask(SIG_BLOCK, &block, &old);
+	portfolioRunning = pthread_create(&portfolioThread, NULL, schedulePortfolio, NULL) == 0;
+	if(jobs >= 0){
+		startFleet(jobs > 0 ? (unsigned long)jobs : fleet_cpus(), strategy, job);
 	}
+	pthread_sigmask(SIG_SETMASK, &old, NULL);
 
-	char cur_sol[100];
-	cur_sol[0] = '\0';
-	unsigned int bestSoFar = EDGE_MAX;
+	const uint32_t *record;
+	unsigned int bestSoFar = maxEdges + 1;
 
 	/*Supervisor Main Loop*/
 	while (1){
 
-	sem_wait(used_sem);
-	
-	/*Copy to Local*/
-	if(circ_buf->edgeCount < bestSoFar ){
-		if(circ_buf->edgeCount == 0){
-			printf("Graph is 3-colorable!\n");
-			circ_buf->termination = 1;
-		} else {
-			bestSoFar = circ_buf->edgeCount;
-			strcpy(cur_sol,circ_buf->solutions[circ_buf->read_pos]);
-	        	printf("Found Solution with %d edges: %s\n",circ_buf->edgeCount,cur_sol);
-			cur_sol[0] = '\0';
+	record = ring_peek(circ_buf);
+	if(record == NULL){
+		/*Only the signal handler and fleetEnded() terminate the ring without leaving the loop
+		itself.*/
+		if(ring_terminated(circ_buf)){
+			printf("Supervisor shuts down.\n");
+			break;
+		}
+		/*Proven optimal. The record of the best solution may still be on its way.*/
+		if(bestSoFar <= ring_best(circ_buf)){
+			if(bestSoFar > maxEdges){
+				printf("No solution with at most %lu edges exists.\n", maxEdges);
+			} else {
+				printf("Solution with %u edges is optimal.\n", bestSoFar);
+			}
+			ring_terminate(circ_buf);
+			break;
+		}
+		if(ring_await(circ_buf, RECORD_GRACE_MS) == -1){
+			printf("Solution with %u edges is optimal, its record got lost.\n",
+				ring_best(circ_buf));
+			ring_terminate(circ_buf);
+			break;
 		}
+		continue;
 	}
-	/*Free read area*/
-	circ_buf->solutions[circ_buf->read_pos][0] = '\0';
-	
-	sem_post(free_sem);
 
-	circ_buf->read_pos = (circ_buf->read_pos + 1) % CIRC_BUF_LEN;
+	unsigned int edgeCount = record[0];
+
+	if(edgeCount == RING_OFFSPRING){
+		if(poolSlots > 0){
+			poolOffer(record+2, record[1]);
+		}
+		ring_release(circ_buf);
+		continue;
+	}
 
-	if(circ_buf->termination == 1){
-		break;
+	/*Generators only push improvements, but they may arrive out of order.*/
+	if(edgeCount < bestSoFar){
+		if(edgeCount == 0){
+			printf("Graph is 3-colorable!\n");
+			ring_terminate(circ_buf);
+			break;
+		} else {
+			bestSoFar = edgeCount;
+			printSolution(record);
+			if(poolSlots > 0){
+				poolOffer(record + 1 + 2*edgeCount, edgeCount);
+			}
+			if(bestSoFar <= __atomic_load_n(&lowerBound, __ATOMIC_RELAXED)){
+				ring_prove(circ_buf);
+			}
+		}
 	}
+	ring_release(circ_buf);
 
 	}
 
+	stopBound();
+	if(ring_wait_detached(circ_buf, DETACH_GRACE_MS) == -1){
+		fprintf(stderr, "%s: Not all generators detached from the shared memory.\n", prog_name);
+	}
+	fleet_stop(&fleet);
+	if(portfolioRunning){
+		portfolioStop = 1;
+		pthread_join(portfolioThread, NULL);
+	}
+	printPortfolio();
+	if(haveGraph){
+		bound_free(&packing);
+		graph_free(&graph);
+	}
+	free(poolWords);
+	free(poolConflicts);
 	cleanup();
 
 	exit(EXIT_SUCCESS);
@@ -161,23 +410,387 @@ int main (int argc, char *argv[]){
 
 
 
+}
+
+/**
+ * Selection for the elite pool.
+ * @brief Decides whether a coloring enters the pool and which one it replaces. Until the pool is
+ * full every coloring enters. A coloring close to one of the pool (less than poolN/POOL_DISTANCE
+ * apart) may only replace that one, and only if it has fewer conflicting edges, so the pool does
+ * not fill up with copies of one coloring. Otherwise it replaces the worst one of the pool if it is
+ * not worse than that.
+ *
+ * @param words the coloring, as stored by coloring_pack()
+ * @param conflicts its number of conflicting edges
+ */
+
+static void poolOffer(const uint32_t *words, unsigned int conflicts){
+	unsigned int minDistance = poolN / POOL_DISTANCE > 0 ? poolN / POOL_DISTANCE : 1;
+	unsigned int closest = 0;
+	unsigned int closestDistance = poolN + 1;
+	unsigned int worst = 0;
+
+	for(unsigned int i = 0; i < poolFilled; i++){
+		unsigned int d = coloring_distance(poolWords + (size_t)i*poolWordsPer, words, poolN);
+
+		if(d < closestDistance){
+			closest = i;
+			closestDistance = d;
+		}
+		if(poolConflicts[i] > poolConflicts[worst]){
+			worst = i;
+		}
+	}
+
+	unsigned int slot;
+
+	if(closestDistance < minDistance){
+		if(conflicts >= poolConflicts[closest]){
+			return;
+		}
+		slot = closest;
+	} else if(poolFilled < poolSlots){
+		slot = poolFilled++;
+	} else {
+		if(conflicts > poolConflicts[worst]){
+			return;
+		}
+		slot = worst;
+	}
+
+	memcpy(poolWords + (size_t)slot*poolWordsPer, words, poolWordsPer*sizeof(uint32_t));
+	poolConflicts[slot] = conflicts;
+	ring_elite_put(circ_buf, slot, words, conflicts);
+}
+
+/**
+ * Check a strategy.
+ * @return 1 if strategy is one the generator knows, 0 otherwise
+ */
+
+static int knownStrategy(const char *strategy){
+	for(size_t i = 0; i < sizeof(strategies)/sizeof(strategies[0]); i++){
+		if(strcmp(strategy, strategies[i]) == 0){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Parse a numeric option.
+ * @brief Calls usage() if str is not a decimal number in [min, max].
+ */
+
+static unsigned long parseNumber(const char *str, unsigned long min, unsigned long max){
+	char *end;
+	unsigned long val;
+
+	errno = 0;
+	val = strtoul(str, &end, 10);
+	if(errno != 0 || end == str || *end != '\0' || *str == '-' || val < min || val > max){
+		usage();
+	}
+	return val;
+}
+
+/**
+ * Print a solution.
+ * @brief Formats a binary record (edge count, then the (u, v) pairs) as "u-v u-v ...".
+ */
+
+static void printSolution(const uint32_t *record){
+	printf("Found Solution with %u edges:",record[0]);
+	for(uint32_t i = 0; i < record[0]; i++){
+		printf(" %u-%u",record[1+2*i],record[2+2*i]);
+	}
+	printf("\n");
+}
+
+/**
+ * Improve the lower bound.
+ * @brief Thread function, packs odd wheels in random orders and publishes every better bound.
+ * Proves the best solution optimal if it meets the bound.
+ *
+ * @return NULL
+ */
+
+static void *improveBound(void *arg){
+	unsigned int fails = 0;
+
+	while(fails < BOUND_ROUNDS && !boundStop && !ring_terminated(circ_buf) &&
+		!ring_proven(circ_buf)){
+		unsigned int bound = bound_pack(&packing, 1, &boundStop);
+
+		if(boundStop || bound <= lowerBound){
+			fails++;
+			continue;
+		}
+		fails = 0;
+		__atomic_store_n(&lowerBound, bound, __ATOMIC_RELAXED);
+		printf("Lower bound: %u edges.\n", bound);
+		if(ring_best(circ_buf) <= bound){
+			ring_prove(circ_buf);
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Stop the bound thread.
+ * @brief Lets a running packing end early and waits for the thread.
+ */
+
+static void stopBound(){
+	if(boundRunning){
+		boundStop = 1;
+		pthread_join(boundThread, NULL);
+		boundRunning = 0;
+	}
+}
+
+/**
+ * Schedule the portfolio.
+ * @brief Thread function, sets the shares of the portfolio strategies from their statistics until
+ * the generators stop.
+ *
+ * @details A discounted upper confidence bound: for every strategy, the gain (edges taken off the
+ * best solution) and the core-seconds of its turns are summed with older periods weighing less.
+ * Its rate, relative to the best rate, plus an exploration term that shrinks with the time the
+ * strategy has had, is its score. The strategy with the highest score gets all turns but the
+ * PORTFOLIO_FLOOR every strategy keeps. evolve only plays if the pool can hold two parents.
+ *
+ * @return NULL
+ */
+
+static void *schedulePortfolio(void *arg){
+	struct timespec period = {PORTFOLIO_PERIOD_MS / 1000, PORTFOLIO_PERIOD_MS % 1000 * 1000000L};
+	struct arm last[RING_ARMS];
+	double gain[RING_ARMS] = {0};
+	double secs[RING_ARMS] = {0};
+	int enabled[RING_ARMS];
+
+	memset(last, 0, sizeof(last));
+	for(unsigned int i = 0; i < RING_ARMS; i++){
+		enabled[i] = i != RING_ARM_EVOLVE || poolSlots >= 2;
+	}
+
+	while(!portfolioStop && !ring_terminated(circ_buf)){
+		double total = 0;
+		double bestRate = 0;
+
+		for(unsigned int i = 0; i < RING_ARMS; i++){
+			struct arm now;
+
+			ring_arm_read(circ_buf, i, &now);
+			gain[i] = gain[i]*PORTFOLIO_DECAY + (now.gain - last[i].gain);
+			secs[i] = secs[i]*PORTFOLIO_DECAY + (now.ms - last[i].ms) / 1000.0;
+			last[i] = now;
+			if(enabled[i]){
+				total += secs[i];
+				if(gain[i] / (secs[i] + 1) > bestRate){
+					bestRate = gain[i] / (secs[i] + 1);
+				}
+			}
+		}
+
+		uint32_t shares[RING_ARMS];
+		uint32_t given = 0;
+		unsigned int leader = RING_ARM_MINCONF;
+		double leaderScore = -1;
+
+		for(unsigned int i = 0; i < RING_ARMS; i++){
+			double rate = gain[i] / (secs[i] + 1);
+			double score = (bestRate > 0 ? rate / bestRate : 0) +
+				PORTFOLIO_EXPLORE*sqrt(log(1 + total) / (secs[i] + 1));
+
+			shares[i] = enabled[i] ? PORTFOLIO_FLOOR : 0;
+			given += shares[i];
+			if(enabled[i] && score > leaderScore){
+				leader = i;
+				leaderScore = score;
+			}
+		}
+		shares[leader] += RING_SHARE_SCALE - given;
+		ring_arm_set(circ_buf, shares);
+
+		nanosleep(&period, NULL);
+	}
+	return NULL;
+}
+
+/**
+ * Print the portfolio statistics.
+ * @brief Turns, core-seconds and gain of every strategy, if any generator played the portfolio.
+ */
+
+static void printPortfolio(){
+	static const char *const names[RING_ARMS] = {"sliced", "minconf", "anneal", "evolve"};
+	struct arm arms[RING_ARMS];
+	uint64_t turns = 0;
+
+	for(unsigned int i = 0; i < RING_ARMS; i++){
+		ring_arm_read(circ_buf, i, &arms[i]);
+		turns += arms[i].turns;
+	}
+	if(turns == 0){
+		return;
+	}
+	printf("Portfolio:");
+	for(unsigned int i = 0; i < RING_ARMS; i++){
+		printf(" %s %lu turns %.1f s %lu edges%s", names[i], (unsigned long)arms[i].turns,
+			arms[i].ms / 1000.0, (unsigned long)arms[i].gain, i+1 < RING_ARMS ? "," : ".\n");
+	}
+}
+
+/**
+ * Create the shared memory of the job.
+ * @brief Creates it exclusively and takes its lock (see ring_own()). If it exists, only its lock
+ * tells whether a supervisor still runs: one that is just starting holds it before it has written
+ * anything. If the lock can be taken, the supervisor that created the segment has died and the
+ * segment is removed while the lock is held, then created again. Errors end the supervisor.
+ *
+ * @param job the job name, for messages
+ *
+ * @return the file descriptor of the new, empty shared memory, it has to stay open until the
+ * supervisor exits
+ */
+
+static int createSegment(const char *job){
+	char msg[RING_JOB_MAX + 64];
+
+	for(int tries = 0; tries < 3; tries++){
+		int fd = shm_open(shmName, O_RDWR | O_CREAT | O_EXCL, 0600);
+
+		if(fd != -1){
+			/*Somebody may have found it unlocked and removed it in between.*/
+			if(ring_own(fd) == 0 && sameSegment(fd)){
+				return fd;
+			}
+			close(fd);
+			continue;
+		}
+		if(errno != EEXIST){
+			err_msg("Could not allocate memory.\n");
+		}
+
+		fd = shm_open(shmName, O_RDONLY, 0600);
+		if(fd == -1){
+			if(errno == ENOENT){
+				continue;
+			}
+			err_msg("Could not open the shared memory.");
+		}
+		if(ring_own(fd) == -1){
+			struct stat st;
+			int owner = 0;
+
+			if(fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(struct circ)){
+				struct circ *old = mmap(NULL, sizeof(struct circ), PROT_READ, MAP_SHARED, fd, 0);
+
+				if(old != MAP_FAILED){
+					owner = old->magic == RING_MAGIC ? old->owner : 0;
+					munmap(old, sizeof(struct circ));
+				}
+			}
+			close(fd);
+			if(owner > 0){
+				snprintf(msg, sizeof(msg), "Job %s is already running (supervisor %d).", job,
+					owner);
+			} else {
+				snprintf(msg, sizeof(msg), "Job %s is already running.", job);
+			}
+			err_msg(msg);
+		}
+		printf("Removing the shared memory a crashed supervisor of job %s left behind.\n", job);
+		shm_unlink(shmName);
+		close(fd);
+	}
+	err_msg("Could not create the shared memory.");
+	return -1;
+}
+
+/**
+ * Check the name of the shared memory.
+ * @return 1 if the name of the shared memory of the job still refers to fd, 0 otherwise
+ */
+
+static int sameSegment(int fd){
+	struct stat mine;
+	struct stat named;
+	int other = shm_open(shmName, O_RDONLY, 0600);
+	int same;
+
+	if(other == -1){
+		return 0;
+	}
+	same = fstat(fd, &mine) == 0 && fstat(other, &named) == 0 && mine.st_dev == named.st_dev &&
+		mine.st_ino == named.st_ino;
+	close(other);
+	return same;
+}
+
+/**
+ * Start the generators.
+ * @brief Runs count generators of the job with the given strategy from the directory the
+ * supervisor was started from. Errors end the supervisor.
+ */
+
+static void startFleet(unsigned long count, char *strategy, char *job){
+	static char path[4096];
+	static char *args[] = {path, "-s", NULL, "-J", NULL, NULL};
+	const char *why;
+	ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - sizeof("generator"));
+
+	while(len > 0 && path[len-1] != '/'){
+		len--;
+	}
+	if(len <= 0){
+		ring_terminate(circ_buf);
+		cleanup();
+		err_msg("Could not find the directory of the supervisor.");
+	}
+	strcpy(path + len, "generator");
+	args[2] = strategy;
+	args[4] = job;
+
+	if(fleet_start(&fleet, args, count, fleetEnded, &why) == -1){
+		ring_terminate(circ_buf);
+		cleanup();
+		err_msg((char *)why);
+	}
+	printf("Running %lu generators.\n", count);
+}
+
+/**
+ * The generators have ended.
+ * @brief Called by the thread watching the fleet once no generator runs and none is going to be
+ * restarted. Unless the search is over anyway, nothing is left to wait for: ends the main loop.
+ */
+
+static void fleetEnded(){
+	if(ring_terminated(circ_buf) || ring_proven(circ_buf)){
+		return;
+	}
+	fprintf(stderr, "%s: All generators have ended.\n", prog_name);
+	ring_terminate(circ_buf);
 }
 
 /**
  * Handles interrupts. 
  * @brief This function handles interrupts and signals the generators to shut down.
  * 
- * @details In order to shut down the generators, a flag is set (circ_buf->termination).
+ * @details It only terminates the ring (ring_terminate() is async-signal-safe): the termination
+ * flag is set, the cancellation epoch advances and everybody sleeping on the ring is woken up. The
+ * main loop then finds the ring empty and terminated and shuts down like after a solution: it stops
+ * the threads, waits for the generators, reaps the fleet, prints the statistics and removes the
+ * segment. Signals after cleanup() are ignored.
  *
  */
 
 static void signal_handler(int signal){
-	if(signal == SIGINT || signal == SIGTERM){
-		circ_buf->termination = 1;
-		sem_post(free_sem);
-		cleanup();
-		printf("Supervisor shuts down.\n");
-		exit(EXIT_SUCCESS);
+	if((signal == SIGINT || signal == SIGTERM) && circ_buf != NULL){
+		ring_terminate(circ_buf);
 	}
 }
 
@@ -192,25 +805,17 @@ static void signal_handler(int signal){
  */
 
 static void cleanup(){	
-	if(munmap(circ_buf,sizeof(*circ_buf)) == -1){
+	struct circ *mapped = circ_buf;
+
+	/*The signal handler must not touch the ring anymore.*/
+	circ_buf = NULL;
+	if(munmap(mapped,circ_size) == -1){
 		err_msg("could not unmap memory.");
 	}
 	
-	if(shm_unlink(SHM_NAME) == -1){
+	if(shm_unlink(shmName) == -1){
 		err_msg("Could not unlink shared memory.\n");
 	}
-
-	printf("\nClosing Semaphores...\n");
-
-	if(sem_close(free_sem) == -1 || sem_close(used_sem) == -1){
-		err_msg("Could not close Semaphores!\n");
-	}
-
-	if(sem_unlink(SEM_1) == -1 || sem_unlink(SEM_2) == -1){
-		err_msg("Could not unlink Semaphores!\n");
-	}
-
-
 }
 
 /**
@@ -221,7 +826,8 @@ static void cleanup(){
  */
 
 static void usage(){
-	printf("%s: Synopsis = ./supervisor\n",prog_name);
+	printf("%s: Synopsis = ./supervisor [-c capacity] [-m maxedges] [-s slotbytes] [-e elites]"
+		" [-j generators] [-g strategy] [-J job] [-f file | 0-1 1-2 ...]\n", prog_name);
 	exit(EXIT_FAILURE);
 }
 
@@ -0,0 +1,714 @@
+/**
+ * @file bignum.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Big number kernels for intmul: multiplication, division, Barrett reduction and modular
+ * exponentiation.
+ *
+ * @details All functions work on struct bignum. Results never keep leading zero limbs, zero has
+ * length 0. Running out of memory is treated like every other error in intmul: a message is
+ * printed and the process exits.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bignum.h"
+
+size_t bn_mul_cutoff = 32;
+
+/**
+ * Allocate or die.
+ * @brief Wrapper around realloc that exits if no memory is left.
+ *
+ * @param ptr the old pointer (or NULL)
+ * @param size the new size in bytes
+ */
+
+static void *xrealloc(void *ptr, size_t size){
+	void *res = realloc(ptr, size == 0 ? 1 : size);
+	if(res == NULL){
+		fprintf(stderr,"bignum: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	return res;
+}
+
+/**
+ * Make room for limbs.
+ * @brief Grows the limb array of a so that it can hold at least n limbs.
+ *
+ * @param a the number
+ * @param n the number of limbs needed
+ */
+
+static void reserve(struct bignum *a, size_t n){
+	if(a->cap < n){
+		a->limb = xrealloc(a->limb, n*sizeof(uint32_t));
+		a->cap = n;
+	}
+}
+
+/**
+ * Strip leading zero limbs.
+ * @brief Adjusts a->len so that the most significant limb is not zero.
+ *
+ * @param a the number
+ */
+
+static void normalize(struct bignum *a){
+	while(a->len > 0 && a->limb[a->len-1] == 0){
+		a->len--;
+	}
+}
+
+void bn_init(struct bignum *a){
+	a->limb = NULL;
+	a->len = 0;
+	a->cap = 0;
+}
+
+void bn_free(struct bignum *a){
+	free(a->limb);
+	bn_init(a);
+}
+
+void bn_copy(struct bignum *r, const struct bignum *a){
+	if(r == a){
+		return;
+	}
+	reserve(r, a->len);
+	if(a->len > 0){
+		memcpy(r->limb, a->limb, a->len*sizeof(uint32_t));
+	}
+	r->len = a->len;
+}
+
+void bn_set_u32(struct bignum *a, uint32_t v){
+	reserve(a, 1);
+	a->limb[0] = v;
+	a->len = 1;
+	normalize(a);
+}
+
+int bn_is_zero(const struct bignum *a){
+	return a->len == 0;
+}
+
+/**
+ * Parse a hexadecimal number.
+ * @brief Reads n hexadecimal digits (upper or lower case) into a.
+ *
+ * @param a the result
+ * @param hex the digits, most significant first
+ * @param n the number of digits
+ *
+ * @return 0 on success, -1 if a character is not a hexadecimal digit or n is 0
+ */
+
+int bn_from_hex(struct bignum *a, const char *hex, size_t n){
+	if(n == 0){
+		return -1;
+	}
+	reserve(a, (n+7)/8);
+	memset(a->limb, 0, ((n+7)/8)*sizeof(uint32_t));
+
+	for(size_t i = 0; i < n; i++){
+		char c = hex[n-1-i];
+		uint32_t d;
+
+		if(c >= '0' && c <= '9'){
+			d = c - '0';
+		} else if(c >= 'A' && c <= 'F'){
+			d = c - 'A' + 10;
+		} else if(c >= 'a' && c <= 'f'){
+			d = c - 'a' + 10;
+		} else {
+			return -1;
+		}
+		a->limb[i/8] |= d << (4*(i%8));
+	}
+	a->len = (n+7)/8;
+	normalize(a);
+	return 0;
+}
+
+/**
+ * Format a number.
+ * @brief Returns a malloc'ed string with the upper case hexadecimal digits of a. Zero is "0".
+ *
+ * @param a the number
+ */
+
+char *bn_to_hex(const struct bignum *a){
+	char *res = xrealloc(NULL, a->len*8+2);
+	size_t pos = 0;
+
+	if(a->len == 0){
+		strcpy(res,"0");
+		return res;
+	}
+
+	pos += sprintf(res,"%X",a->limb[a->len-1]);
+	for(size_t i = a->len-1; i > 0; i--){
+		pos += sprintf(res+pos,"%08X",a->limb[i-1]);
+	}
+	return res;
+}
+
+/**
+ * Compare limb arrays.
+ * @brief Compares two arrays of the same length n.
+ *
+ * @return -1, 0 or 1 like strcmp
+ */
+
+static int cmp_n(const uint32_t *a, const uint32_t *b, size_t n){
+	for(size_t i = n; i > 0; i--){
+		if(a[i-1] != b[i-1]){
+			return a[i-1] < b[i-1] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+int bn_cmp(const struct bignum *a, const struct bignum *b){
+	if(a->len != b->len){
+		return a->len < b->len ? -1 : 1;
+	}
+	return cmp_n(a->limb, b->limb, a->len);
+}
+
+/**
+ * Add in place.
+ * @brief Adds src (slen limbs) to dst (dlen limbs, dlen >= slen) and propagates the carry.
+ *
+ * @return the carry out of the most significant limb of dst
+ */
+
+static uint32_t add_at(uint32_t *dst, size_t dlen, const uint32_t *src, size_t slen){
+	uint64_t carry = 0;
+	size_t i;
+
+	for(i = 0; i < slen; i++){
+		carry += (uint64_t)dst[i] + src[i];
+		dst[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+	for(; carry != 0 && i < dlen; i++){
+		carry += dst[i];
+		dst[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+	return (uint32_t)carry;
+}
+
+/**
+ * Subtract in place.
+ * @brief Subtracts src (slen limbs) from dst (dlen limbs, dlen >= slen).
+ *
+ * @return the borrow out of the most significant limb of dst
+ */
+
+static uint32_t sub_at(uint32_t *dst, size_t dlen, const uint32_t *src, size_t slen){
+	uint64_t borrow = 0;
+	size_t i;
+
+	for(i = 0; i < slen; i++){
+		uint64_t t = (uint64_t)dst[i] - src[i] - borrow;
+		dst[i] = (uint32_t)t;
+		borrow = (t >> 32) & 1;
+	}
+	for(; borrow != 0 && i < dlen; i++){
+		uint64_t t = (uint64_t)dst[i] - borrow;
+		dst[i] = (uint32_t)t;
+		borrow = (t >> 32) & 1;
+	}
+	return (uint32_t)borrow;
+}
+
+/**
+ * Schoolbook multiplication.
+ * @brief r = a*b, r must have room for an+bn limbs and must not overlap a or b.
+ */
+
+static void mul_school(uint32_t *r, const uint32_t *a, size_t an, const uint32_t *b, size_t bn){
+	memset(r, 0, (an+bn)*sizeof(uint32_t));
+	for(size_t i = 0; i < an; i++){
+		uint64_t carry = 0;
+		uint64_t ai = a[i];
+
+		if(ai == 0){
+			continue;
+		}
+		for(size_t j = 0; j < bn; j++){
+			carry += ai*b[j] + r[i+j];
+			r[i+j] = (uint32_t)carry;
+			carry >>= 32;
+		}
+		r[i+bn] = (uint32_t)carry;
+	}
+}
+
+/**
+ * Recursive multiplication kernel.
+ * @brief r = a*b for two numbers of n limbs each, r gets 2n limbs.
+ *
+ * @details This is the formula of the forking intmul, done in-process: the operands are split
+ * into a high and a low half, al*bl and ah*bh are written directly into the low and high half of
+ * r and the two cross products are added in the middle. If n is odd the high half is one limb
+ * longer, the low halves are zero-extended for the cross products.
+ *
+ * @param r the result, 2n limbs, must not overlap a or b
+ * @param a first operand
+ * @param b second operand
+ * @param n the number of limbs of both operands
+ */
+
+static void mul_rec(uint32_t *r, const uint32_t *a, const uint32_t *b, size_t n){
+	if(n < bn_mul_cutoff || n < 2){
+		mul_school(r, a, n, b, n);
+		return;
+	}
+
+	size_t h = n/2;
+	size_t hi = n-h;
+
+	mul_rec(r, a, b, h);
+	mul_rec(r+2*h, a+h, b+h, hi);
+
+	uint32_t *tmp = xrealloc(NULL, 4*hi*sizeof(uint32_t));
+	uint32_t *low = tmp;
+	uint32_t *cross = tmp+2*hi;
+
+	/*ah*bl*/
+	memcpy(low, b, h*sizeof(uint32_t));
+	low[h] = 0;
+	mul_rec(cross, a+h, low, hi);
+	add_at(r+h, 2*n-h, cross, 2*hi);
+
+	/*al*bh*/
+	memcpy(low, a, h*sizeof(uint32_t));
+	low[h] = 0;
+	mul_rec(cross, low, b+h, hi);
+	add_at(r+h, 2*n-h, cross, 2*hi);
+
+	free(tmp);
+}
+
+/**
+ * Multiply two numbers.
+ * @brief r = a*b. r may be the same object as a or b.
+ *
+ * @details Both operands are zero-extended to the same length and handed to mul_rec().
+ */
+
+void bn_mul(struct bignum *r, const struct bignum *a, const struct bignum *b){
+	size_t n = a->len > b->len ? a->len : b->len;
+
+	if(a->len == 0 || b->len == 0){
+		r->len = 0;
+		return;
+	}
+
+	uint32_t *buf = xrealloc(NULL, 4*n*sizeof(uint32_t));
+	uint32_t *pa = buf;
+	uint32_t *pb = buf+n;
+	uint32_t *res = NULL;
+
+	memcpy(pa, a->limb, a->len*sizeof(uint32_t));
+	memset(pa+a->len, 0, (n-a->len)*sizeof(uint32_t));
+	memcpy(pb, b->limb, b->len*sizeof(uint32_t));
+	memset(pb+b->len, 0, (n-b->len)*sizeof(uint32_t));
+
+	res = buf+2*n;
+	mul_rec(res, pa, pb, n);
+
+	reserve(r, 2*n);
+	memcpy(r->limb, res, 2*n*sizeof(uint32_t));
+	r->len = 2*n;
+	normalize(r);
+	free(buf);
+}
+
+/**
+ * Add a shifted number.
+ * @brief r += a * 2^bits.
+ *
+ * @details Used to put the sub-products of a split multiplication back together.
+ */
+
+void bn_add_shifted(struct bignum *r, const struct bignum *a, size_t bits){
+	size_t off = bits/32;
+	int s = bits%32;
+	size_t alen = a->len+1;
+	size_t need;
+
+	if(a->len == 0){
+		return;
+	}
+	need = (r->len > off+alen ? r->len : off+alen)+1;
+	reserve(r, need);
+	memset(r->limb+r->len, 0, (need-r->len)*sizeof(uint32_t));
+
+	uint32_t *tmp = xrealloc(NULL, alen*sizeof(uint32_t));
+	tmp[0] = a->limb[0] << s;
+	for(size_t i = 1; i < a->len; i++){
+		tmp[i] = (a->limb[i] << s) | (s ? (uint32_t)((uint64_t)a->limb[i-1] >> (32-s)) : 0);
+	}
+	tmp[a->len] = s ? (uint32_t)((uint64_t)a->limb[a->len-1] >> (32-s)) : 0;
+
+	add_at(r->limb+off, need-off, tmp, alen);
+	r->len = need;
+	normalize(r);
+	free(tmp);
+}
+
+/**
+ * Divide with remainder.
+ * @brief q = a / m, r = a % m (Knuth, algorithm D). q may be NULL.
+ *
+ * @details Only used to set up the Barrett constant and to reduce the inputs once, the hot
+ * path never divides.
+ *
+ * @return 0 on success, -1 if m is zero
+ */
+
+int bn_divmod(struct bignum *q, struct bignum *r, const struct bignum *a, const struct bignum *m){
+	size_t n = m->len;
+
+	if(n == 0){
+		return -1;
+	}
+	if(bn_cmp(a, m) < 0){
+		bn_copy(r, a);
+		if(q != NULL){
+			q->len = 0;
+		}
+		return 0;
+	}
+
+	size_t len = a->len;
+	size_t qlen = len-n+1;
+	uint32_t *quot = xrealloc(NULL, qlen*sizeof(uint32_t));
+
+	if(n == 1){
+		uint64_t rem = 0;
+		for(size_t i = len; i > 0; i--){
+			uint64_t cur = (rem << 32) | a->limb[i-1];
+			quot[i-1] = (uint32_t)(cur / m->limb[0]);
+			rem = cur % m->limb[0];
+		}
+		bn_set_u32(r, (uint32_t)rem);
+	} else {
+		/*Normalize so that the top bit of the divisor is set.*/
+		int s = __builtin_clz(m->limb[n-1]);
+		uint32_t *un = xrealloc(NULL, (len+1)*sizeof(uint32_t));
+		uint32_t *vn = xrealloc(NULL, n*sizeof(uint32_t));
+
+		for(size_t i = n-1; i > 0; i--){
+			vn[i] = (m->limb[i] << s) | (s ? (uint32_t)((uint64_t)m->limb[i-1] >> (32-s)) : 0);
+		}
+		vn[0] = m->limb[0] << s;
+		un[len] = s ? (uint32_t)((uint64_t)a->limb[len-1] >> (32-s)) : 0;
+		for(size_t i = len-1; i > 0; i--){
+			un[i] = (a->limb[i] << s) | (s ? (uint32_t)((uint64_t)a->limb[i-1] >> (32-s)) : 0);
+		}
+		un[0] = a->limb[0] << s;
+
+		for(size_t j = qlen; j > 0; j--){
+			size_t jj = j-1;
+			uint64_t num = ((uint64_t)un[jj+n] << 32) | un[jj+n-1];
+			uint64_t qhat = num / vn[n-1];
+			uint64_t rhat = num % vn[n-1];
+
+			while(qhat > 0xFFFFFFFFull ||
+				qhat*vn[n-2] > ((rhat << 32) | un[jj+n-2])){
+				qhat--;
+				rhat += vn[n-1];
+				if(rhat > 0xFFFFFFFFull){
+					break;
+				}
+			}
+
+			/*Multiply and subtract.*/
+			uint64_t borrow = 0;
+			uint64_t carry = 0;
+			for(size_t i = 0; i < n; i++){
+				uint64_t p = qhat*vn[i] + carry;
+				carry = p >> 32;
+				uint64_t t = (uint64_t)un[i+jj] - (uint32_t)p - borrow;
+				un[i+jj] = (uint32_t)t;
+				borrow = (t >> 32) & 1;
+			}
+			uint64_t t = (uint64_t)un[jj+n] - carry - borrow;
+			un[jj+n] = (uint32_t)t;
+
+			if((t >> 32) & 1){
+				/*Subtracted one time too often, add back.*/
+				qhat--;
+				add_at(un+jj, n+1, vn, n);
+			}
+			quot[jj] = (uint32_t)qhat;
+		}
+
+		reserve(r, n);
+		for(size_t i = 0; i < n; i++){
+			r->limb[i] = (un[i] >> s) | (s ? (uint32_t)((uint64_t)un[i+1] << (32-s)) : 0);
+		}
+		r->len = n;
+		normalize(r);
+		free(un);
+		free(vn);
+	}
+
+	if(q != NULL){
+		reserve(q, qlen);
+		memcpy(q->limb, quot, qlen*sizeof(uint32_t));
+		q->len = qlen;
+		normalize(q);
+	}
+	free(quot);
+	return 0;
+}
+
+/**
+ * Set up Barrett reduction.
+ * @brief Stores the modulus and mu = floor(b^(2k) / m) with b = 2^32 and k the limb count of m.
+ *
+ * @return 0 on success, -1 if m is zero
+ */
+
+int barrett_init(struct barrett *br, const struct bignum *m){
+	struct bignum pow;
+
+	if(bn_is_zero(m)){
+		return -1;
+	}
+	bn_init(&br->m);
+	bn_init(&br->mu);
+	bn_copy(&br->m, m);
+	br->k = m->len;
+
+	bn_init(&pow);
+	reserve(&pow, 2*br->k+1);
+	memset(pow.limb, 0, (2*br->k+1)*sizeof(uint32_t));
+	pow.limb[2*br->k] = 1;
+	pow.len = 2*br->k+1;
+
+	struct bignum rem;
+	bn_init(&rem);
+	bn_divmod(&br->mu, &rem, &pow, m);
+	bn_free(&rem);
+	bn_free(&pow);
+	return 0;
+}
+
+void barrett_free(struct barrett *br){
+	bn_free(&br->m);
+	bn_free(&br->mu);
+}
+
+/**
+ * Barrett reduction.
+ * @brief r = x mod m for 0 <= x < b^(2k).
+ *
+ * @details q3 = ((x / b^(k-1)) * mu) / b^(k+1) underestimates x / m by at most two, so the
+ * remainder x - q3*m (computed modulo b^(k+1)) needs at most two final subtractions.
+ */
+
+static void barrett_reduce(const struct barrett *br, struct bignum *r, const struct bignum *x){
+	size_t k = br->k;
+	struct bignum q;
+	struct bignum t;
+
+	if(x->len < k || (x->len == k && cmp_n(x->limb, br->m.limb, k) < 0)){
+		bn_copy(r, x);
+		return;
+	}
+
+	bn_init(&q);
+	bn_init(&t);
+
+	/*q1 = x / b^(k-1)*/
+	q.limb = x->limb+(k-1);
+	q.len = x->len-(k-1);
+	bn_mul(&t, &q, &br->mu);
+
+	/*q3 = q2 / b^(k+1)*/
+	bn_init(&q);
+	if(t.len > k+1){
+		q.len = t.len-(k+1);
+		q.limb = xrealloc(NULL, q.len*sizeof(uint32_t));
+		q.cap = q.len;
+		memcpy(q.limb, t.limb+k+1, q.len*sizeof(uint32_t));
+	}
+	bn_mul(&t, &q, &br->m);
+
+	/*r = (x mod b^(k+1)) - (q3*m mod b^(k+1)), wrapping modulo b^(k+1)*/
+	uint32_t *res = xrealloc(NULL, (k+1)*sizeof(uint32_t));
+	size_t xl = x->len < k+1 ? x->len : k+1;
+	size_t tl = t.len < k+1 ? t.len : k+1;
+
+	memset(res, 0, (k+1)*sizeof(uint32_t));
+	memcpy(res, x->limb, xl*sizeof(uint32_t));
+	sub_at(res, k+1, t.limb, tl);
+
+	uint32_t *mod = xrealloc(NULL, (k+1)*sizeof(uint32_t));
+	memcpy(mod, br->m.limb, k*sizeof(uint32_t));
+	mod[k] = 0;
+	while(cmp_n(res, mod, k+1) >= 0){
+		sub_at(res, k+1, mod, k+1);
+	}
+
+	reserve(r, k+1);
+	memcpy(r->limb, res, (k+1)*sizeof(uint32_t));
+	r->len = k+1;
+	normalize(r);
+
+	free(mod);
+	free(res);
+	bn_free(&q);
+	bn_free(&t);
+}
+
+/**
+ * Modular multiplication.
+ * @brief r = a*b mod m. a and b must already be reduced modulo m.
+ */
+
+void bn_modmul(struct bignum *r, const struct bignum *a, const struct bignum *b,
+	const struct barrett *br){
+	struct bignum t;
+
+	bn_init(&t);
+	bn_mul(&t, a, b);
+	barrett_reduce(br, r, &t);
+	bn_free(&t);
+}
+
+/**
+ * Test an exponent bit.
+ * @return bit i of a
+ */
+
+static int bit(const struct bignum *a, size_t i){
+	return (a->limb[i/32] >> (i%32)) & 1;
+}
+
+/**
+ * Pick a window size.
+ * @brief Returns the window size that needs the fewest multiplications for an exponent with the
+ * given number of bits.
+ */
+
+static int default_window(size_t bits){
+	if(bits <= 24){
+		return 2;
+	} else if(bits <= 80){
+		return 3;
+	} else if(bits <= 240){
+		return 4;
+	} else if(bits <= 672){
+		return 5;
+	} else if(bits <= 1792){
+		return 6;
+	}
+	return 7;
+}
+
+/**
+ * Modular exponentiation.
+ * @brief r = base^exp mod m using left-to-right sliding windows.
+ *
+ * @details The odd powers base^1, base^3, ..., base^(2^w - 1) are computed once, then the exponent
+ * is scanned from the top: zero bits cost one squaring, every window of up to w bits that starts
+ * and ends with a one costs its squarings plus one multiplication with a table entry. All
+ * reductions share the precomputed Barrett data in br.
+ *
+ * @param r the result
+ * @param base the base, any size
+ * @param exp the exponent
+ * @param br the precomputed modulus
+ * @param window the window size in bits, 0 picks one from the exponent length
+ */
+
+void bn_modexp(struct bignum *r, const struct bignum *base, const struct bignum *exp,
+	const struct barrett *br, int window){
+	struct bignum one;
+	struct bignum g;
+	struct bignum g2;
+
+	bn_init(&one);
+	bn_set_u32(&one, 1);
+	bn_init(&g);
+	bn_divmod(NULL, &g, base, &br->m);
+
+	if(bn_is_zero(exp)){
+		bn_divmod(NULL, r, &one, &br->m);
+		bn_free(&one);
+		bn_free(&g);
+		return;
+	}
+
+	size_t bits = exp->len*32 - __builtin_clz(exp->limb[exp->len-1]);
+	if(window <= 0){
+		window = default_window(bits);
+	}
+
+	size_t tlen = (size_t)1 << (window-1);
+	struct bignum *table = xrealloc(NULL, tlen*sizeof(struct bignum));
+
+	bn_init(&g2);
+	bn_modmul(&g2, &g, &g, br);
+	bn_init(&table[0]);
+	bn_copy(&table[0], &g);
+	for(size_t i = 1; i < tlen; i++){
+		bn_init(&table[i]);
+		bn_modmul(&table[i], &table[i-1], &g2, br);
+	}
+
+	int started = 0;
+	size_t i = bits;
+
+	while(i > 0){
+		if(bit(exp, i-1) == 0){
+			if(started){
+				bn_modmul(r, r, r, br);
+			}
+			i--;
+			continue;
+		}
+
+		/*Longest window [i-1 .. l] of at most w bits that ends in a one.*/
+		size_t l = i > (size_t)window ? i-window : 0;
+		while(bit(exp, l) == 0){
+			l++;
+		}
+		uint32_t val = 0;
+		for(size_t j = i; j > l; j--){
+			val = (val << 1) | bit(exp, j-1);
+		}
+
+		if(started){
+			for(size_t j = l; j < i; j++){
+				bn_modmul(r, r, r, br);
+			}
+			bn_modmul(r, r, &table[val/2], br);
+		} else {
+			bn_copy(r, &table[val/2]);
+			started = 1;
+		}
+		i = l;
+	}
+
+	for(size_t j = 0; j < tlen; j++){
+		bn_free(&table[j]);
+	}
+	free(table);
+	bn_free(&g2);
+	bn_free(&g);
+	bn_free(&one);
+}
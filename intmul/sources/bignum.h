@@ -0,0 +1,56 @@
+/**
+ * @file bignum.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief In-process big number arithmetic used by the modular modes of intmul.
+ *
+ * @details Numbers are stored as little endian arrays of 32 bit limbs. The multiplication kernel
+ * uses the same split as the forking intmul (A*B = ah*bh*16^n + (ah*bl + al*bh)*16^(n/2) + al*bl),
+ * but recurses in-process and falls back to schoolbook multiplication below a cutoff. On top of
+ * that there is Barrett reduction and sliding-window exponentiation.
+ *
+ */
+
+#ifndef BIGNUM_H
+#define BIGNUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct bignum{
+	uint32_t *limb;
+	size_t len;
+	size_t cap;
+};
+
+/*Precomputed modulus data, reused by every reduction.*/
+struct barrett{
+	struct bignum m;
+	struct bignum mu;
+	size_t k;
+};
+
+/*Operand length (in limbs) below which the kernel multiplies schoolbook.*/
+extern size_t bn_mul_cutoff;
+
+void bn_init(struct bignum *a);
+void bn_free(struct bignum *a);
+void bn_copy(struct bignum *r, const struct bignum *a);
+void bn_set_u32(struct bignum *a, uint32_t v);
+int bn_is_zero(const struct bignum *a);
+int bn_from_hex(struct bignum *a, const char *hex, size_t n);
+char *bn_to_hex(const struct bignum *a);
+int bn_cmp(const struct bignum *a, const struct bignum *b);
+void bn_mul(struct bignum *r, const struct bignum *a, const struct bignum *b);
+void bn_add_shifted(struct bignum *r, const struct bignum *a, size_t bits);
+int bn_divmod(struct bignum *q, struct bignum *r, const struct bignum *a, const struct bignum *m);
+
+int barrett_init(struct barrett *br, const struct bignum *m);
+void barrett_free(struct barrett *br);
+void bn_modmul(struct bignum *r, const struct bignum *a, const struct bignum *b,
+	const struct barrett *br);
+void bn_modexp(struct bignum *r, const struct bignum *base, const struct bignum *exp,
+	const struct barrett *br, int window);
+
+#endif
@@ -8,6 +8,16 @@
  * 2 in order for the seperation to work correctly. Each one of the numbers is split into two parts, 
  * those are then multiplied and added back together using the stated formula.	
  *
+ * With -m or -e the program works as a modular calculator instead: it reads three numbers and
+ * computes a*b mod m or base^exp mod m in-process, built on the kernels in bignum.c.
+ *
+ * With -c the top levels of the recursion tree are not forked but sent to intmul-worker daemons
+ * over sockets, using the same text protocol child() uses on its pipes. A worker that cannot be
+ * reached within CONNECT_TIMEOUT_MS counts as dead, like one that closes the connection, and its
+ * task is retried on another worker. A task that is not answered in time (-t seconds, by default
+ * scaled to the length of the factors, see distributed()) is retried too, but the worker stays in
+ * use, it may just be slow. A task is given up after TASK_RETRIES retries.
+ *
  */
 
 #include <stdio.h>
@@ -20,12 +30,67 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <signal.h>
+#include <limits.h>
+#include <time.h>
+#include "bignum.h"
+#include "net.h"
+
+#define MAX_DEPTH 8
+
+/*Time limits of the distributed mode: connecting to a worker, and by default a task from sending
+it until the answer is complete, TASK_TIMEOUT_MS plus 1 ms per TASK_SQUARE_DIGITS digits squared
+(the workers multiply in quadratic time, this is about ten times slower than a worker takes).*/
+#define CONNECT_TIMEOUT_MS 5000
+#define TASK_TIMEOUT_MS 10000
+#define TASK_SQUARE_DIGITS 3000000
+
+/*Most seconds -t accepts.*/
+#define MAX_TIMEOUT 1000000
+
+/*How often a task is retried before the coordinator gives up.*/
+#define TASK_RETRIES 4
+
+enum mode {MODE_MUL, MODE_MODMUL, MODE_MODEXP, MODE_REMOTE};
+
+/*One sub-product of the distributed mode, retries counts how often it failed.*/
+struct task{
+	char *numa;
+	char *numb;
+	size_t shift;
+	char *result;
+	int retries;
+};
+
+/*One intmul-worker, it runs at most one task at a time. deadline is when its task times out, in
+milliseconds of now_ms(), timeouts counts its tasks that timed out since its last answer.*/
+struct remote{
+	char *addr;
+	int fd;
+	int task;
+	long long deadline;
+	int timeouts;
+	int dead;
+	char *buf;
+	size_t len;
+	size_t cap;
+};
 
 static void usage();
 static void err_msg(char *msg);
 static int child(char *numa, char *numb,char *resp); 
 static char *combineResults(char *ah_bh, char *ah_bl, char *al_bh, char *al_bl, int len);
 static char *addNumbers(char *num1, int shift1, char *num2);
+static void modular(enum mode mode, int window);
+static void readNumber(struct bignum *num, const char *what);
+static void distributed(char *workers, int depth, long long timeout);
+static int dispatch(struct remote *r, struct task *tasks, int t, long long timeout);
+static void requeue(struct task *tasks, int *queue, int ntasks, int head, int *pending, int t);
+static int receive(struct remote *r, struct task *tasks);
+static long long now_ms();
 
 char *prog_name;
 
@@ -44,10 +109,72 @@ char *prog_name;
 int main (int argc, char *argv[]){
 	prog_name = argv[0];
 	
-	if(argc > 1){
+	enum mode mode = MODE_MUL;
+	int window = 0;
+	int depth = 0;
+	long timeout = 0;
+	char *workers = NULL;
+	int c;
+
+	while((c = getopt(argc, argv, "mew:c:d:t:")) != -1){
+		switch(c){
+			case 'm':
+				if(mode != MODE_MUL){
+					usage();
+				}
+				mode = MODE_MODMUL;
+				break;
+			case 'e':
+				if(mode != MODE_MUL){
+					usage();
+				}
+				mode = MODE_MODEXP;
+				break;
+			case 'c':
+				if(mode != MODE_MUL){
+					usage();
+				}
+				mode = MODE_REMOTE;
+				workers = optarg;
+				break;
+			case 'd':
+				depth = strtol(optarg, NULL, 10);
+				if(depth < 1 || depth > MAX_DEPTH){
+					err_msg("The depth must be between 1 and 8!");
+				}
+				break;
+			case 't':
+				timeout = strtol(optarg, NULL, 10);
+				if(timeout < 1 || timeout > MAX_TIMEOUT){
+					err_msg("The timeout must be between 1 and 1000000 seconds!");
+				}
+				break;
+			case 'w':
+				window = strtol(optarg, NULL, 10);
+				if(window < 1 || window > 16){
+					err_msg("The window size must be between 1 and 16!");
+				}
+				break;
+			default:
+				usage();
+		}
+	}
+
+	if(optind < argc || (window != 0 && mode != MODE_MODEXP) || (depth != 0 && mode != MODE_REMOTE) ||
+		(timeout != 0 && mode != MODE_REMOTE)){
 		usage();
 	}
 
+	if(mode == MODE_REMOTE){
+		distributed(workers, depth == 0 ? 1 : depth, timeout*1000LL);
+		exit(EXIT_SUCCESS);
+	}
+
+	if(mode != MODE_MUL){
+		modular(mode, window);
+		exit(EXIT_SUCCESS);
+	}
+
 
 	char *numa = NULL;
 	char *numb = NULL;
@@ -116,20 +243,20 @@ int main (int argc, char *argv[]){
 	int len = strlen(numa)-1;  //because of newline
 	int halflen = len/2;
 	
-	char *ah = calloc(halflen,sizeof(char));
-	char *al = calloc(halflen,sizeof(char));
-	char *bh = calloc(halflen,sizeof(char));
-	char *bl = calloc(halflen,sizeof(char));
+	char *ah = calloc(halflen+1,sizeof(char));
+	char *al = calloc(halflen+1,sizeof(char));
+	char *bh = calloc(halflen+1,sizeof(char));
+	char *bl = calloc(halflen+1,sizeof(char));
 
 	strncpy(ah,numa,halflen);
 	strncpy(al,numa+halflen,halflen);
 	strncpy(bh,numb,halflen);
 	strncpy(bl,numb+halflen,halflen);
 
-	char *res_1 = calloc(2*halflen+1,sizeof(char)); //ah*bh
-	char *res_2 = calloc(2*halflen+1,sizeof(char)); //ah*bl
-	char *res_3 = calloc(2*halflen+1,sizeof(char)); //al*bh
-	char *res_4 = calloc(2*halflen+1,sizeof(char)); //al*bl
+	char *res_1 = calloc(2*halflen+2,sizeof(char)); //ah*bh
+	char *res_2 = calloc(2*halflen+2,sizeof(char)); //ah*bl
+	char *res_3 = calloc(2*halflen+2,sizeof(char)); //al*bh
+	char *res_4 = calloc(2*halflen+2,sizeof(char)); //al*bl
 
 
 
@@ -146,10 +273,10 @@ int main (int argc, char *argv[]){
 	//A*B = res_1 * 16^n + res_2 * 16^(n/2) + res_3 * 16^(n/2)
 	int n = strlen(numa)-1;
 
-	char *resultOfComputation = calloc(2*len+1,sizeof(char));
-	resultOfComputation = combineResults(res_1,res_2,res_3,res_4,n); 
+	char *resultOfComputation = combineResults(res_1,res_2,res_3,res_4,n); 
 
 	fprintf(stdout,"%s\n",resultOfComputation); 
+	free(resultOfComputation);
 	
 	free(res_1);
 	free(res_2);
@@ -195,6 +322,8 @@ static char *combineResults(char *ah_bh, char *ah_bl, char *al_bh, char *al_bl,
 
 	char *res3 = addNumbers(ah_bh,len,res2);
 
+	free(res1);
+	free(res2);
 	return res3;
 }
 
@@ -216,129 +345,68 @@ static char *combineResults(char *ah_bh, char *ah_bl, char *al_bh, char *al_bl,
 
 static char *addNumbers(char *num1, int shift1, char *num2){
 
-	if(num1[strlen(num1)-1] == '\n'){
+	if(strlen(num1) > 0 && num1[strlen(num1)-1] == '\n'){
 		num1[strlen(num1)-1] = '\0';
 	}
-
-	//shift number1 to the left first	
-	char number_shifted[strlen(num1)+shift1];
-	sprintf(number_shifted,"%s",num1);
-	
-	if(number_shifted[strlen(number_shifted)-1] == '\n'){
-		number_shifted[strlen(number_shifted)-1] = '\0';
-	}
-	
-	char zero[shift1];
-	
-	for(int i = 0; i < shift1; i++){
-		zero[i] = '0';
+	if(strlen(num2) > 0 && num2[strlen(num2)-1] == '\n'){
+		num2[strlen(num2)-1] = '\0';
 	}
-	strcat(number_shifted,zero);
-	
-	number_shifted[strlen(num1)+shift1] = '\0';
 
-	char newNumber2[strlen(num2)];
-	sprintf(newNumber2,"%s",num2);
+	//numbers must have same length -> pad the shorter one with leading zeros
+	int len1 = strlen(num1)+shift1;
+	int len2 = strlen(num2);
+	int len = len1 > len2 ? len1 : len2;
 
-	if(newNumber2[strlen(newNumber2)-1] == '\n'){
-		newNumber2[strlen(newNumber2)-1] = '\0';
+	char *num_shifted = malloc(len+1);
+	char *number2 = malloc(len+1);
+	if(num_shifted == NULL || number2 == NULL){
+		err_msg("malloc");
 	}
 
-	newNumber2[strlen(newNumber2)] = '\0';
-
-	char *number2 = malloc(strlen(newNumber2)+strlen(number_shifted));
-	char *num_shifted = malloc(strlen(newNumber2)+strlen(number_shifted));
+	//shift number1 to the left first
+	memset(num_shifted,'0',len);
+	memcpy(num_shifted+len-len1,num1,strlen(num1));
+	num_shifted[len] = '\0';
 
-	//numbers must have same length
-	if(strlen(newNumber2) != strlen(number_shifted)){
-		if(strlen(newNumber2) < strlen(number_shifted)){
-			int a = strlen(number_shifted);
-			int b = strlen(newNumber2);
-			int diff = a - b;
-			char help[strlen(number_shifted)];
-			for(int k = 0; k < diff; k++){
-				help[k] = '0';
-			}
-			help[diff] = '\0';
-			strcat(help,newNumber2);
-			strcpy(number2,help);
-			strncpy(num_shifted,number_shifted,strlen(number_shifted));
-		} else {
-			int diff = strlen(newNumber2)-strlen(number_shifted);
-			char help[strlen(newNumber2)];
-			for(int k = 0; k < diff; k++){
-				help[k] = '0';
-			}
-			help[diff] = '\0';
-			strcat(help,number_shifted);
-			strcpy(num_shifted,help);
-			strcpy(number2,newNumber2);
-		}
-	} else {
-		strcpy(number2,newNumber2);
-		strcpy(num_shifted,number_shifted);
-	}
+	memset(number2,'0',len-len2);
+	strcpy(number2+len-len2,num2);
 	
 	//begin to Add
 
-	char *response = malloc(strlen(num_shifted)+strlen(number2));
+	//one more digit for the carry
+	char *response = malloc(len+2);
 	if(response == NULL){
 		err_msg("malloc_1");
 	}
-	for(int k = 0; k < strlen(num_shifted); k++){
-		response[k] = '0';
-	}
+	response[len+1] = '\0';
 
 	int carry = 0;
 	int digit1;
 	int digit2;
 	int temp_res;
-	char temp_hex[1];
-	char temp_str[2];
-	int res_digit;
-	int res_idx = strlen(response)-1;
-
-	int mem_len = strlen(num_shifted);
+	char digit_str[2] = {'\0','\0'};
 
-	for(int k = 0; k < mem_len;k++){
-		digit1 = strtol(num_shifted+strlen(num_shifted)-1,NULL,16);
-		digit2 = strtol(number2+strlen(number2)-1,NULL,16);
+	for(int k = len-1; k >= 0; k--){
+		digit_str[0] = num_shifted[k];
+		digit1 = strtol(digit_str,NULL,16);
+		digit_str[0] = number2[k];
+		digit2 = strtol(digit_str,NULL,16);
 
 		temp_res = digit1 + digit2 + carry;
 		carry = temp_res/(0x10);
-		res_digit = temp_res%(0x10);
-		
-		sprintf(temp_str,"%X",res_digit);
-		strncpy(temp_hex,temp_str,1);
-	
-		response[res_idx] = temp_hex[0];
-		res_idx--;
-
-		num_shifted[strlen(num_shifted)-1] = '\0';
-		number2[strlen(number2)-1] = '\0';
+		response[k+1] = "0123456789ABCDEF"[temp_res%(0x10)];
 	}
 
-	if(carry != 0){
-		sprintf(temp_str,"%X",carry);
-		strncpy(temp_hex,temp_str,1);
-
-		char *fullResp = malloc((strlen(response)*strlen(temp_hex))*sizeof(char));
-		if(fullResp == NULL){
-			err_msg("malloc");
-		}
-
-
-		fullResp[0] = temp_hex[0];
-		strcat(fullResp,response);
-		return fullResp;
-
+	free(num_shifted);
+	free(number2);
 
+	if(carry != 0){
+		response[0] = "0123456789ABCDEF"[carry];
+		return response;
 	}
-	
-	return response;
-	
-
 
+	memmove(response,response+1,len+1);
+	return response;
 }
 
 /**
@@ -426,6 +494,449 @@ static int child(char *numa, char *numb, char *resp){
 	}
 }
 
+/**
+ * Read one operand of the modular modes.
+ * @brief Reads a line from stdin and parses it as a hexadecimal number.
+ *
+ * @details Unlike the plain multiplication the numbers do not need to have the same length or a
+ * length that is a power of 2.
+ *
+ * @param num the parsed number
+ * @param what the name of the operand, used in the error message
+ *
+ */
+
+static void readNumber(struct bignum *num, const char *what){
+	char *line = NULL;
+	size_t cap = 0;
+	ssize_t len = getline(&line, &cap, stdin);
+
+	if(len <= 0){
+		free(line);
+		fprintf(stderr,"%s: Missing %s!\n",prog_name,what);
+		exit(EXIT_FAILURE);
+	}
+	while(len > 0 && (line[len-1] == '\n' || line[len-1] == '\r')){
+		len--;
+	}
+	if(bn_from_hex(num, line, len) == -1){
+		free(line);
+		fprintf(stderr,"%s: The %s is not a valid number!\n",prog_name,what);
+		exit(EXIT_FAILURE);
+	}
+	free(line);
+}
+
+/**
+ * Modular multiplication and exponentiation.
+ * @brief Reads three numbers from stdin (one per line) and prints a*b mod m (-m) or
+ * base^exp mod m (-e).
+ *
+ * @details The modulus is prepared for Barrett reduction once and this data is reused by every
+ * multiplication. Exponentiation uses sliding windows over the exponent bits.
+ *
+ * @param mode MODE_MODMUL or MODE_MODEXP
+ * @param window the window size for the exponentiation, 0 chooses one automatically
+ *
+ */
+
+static void modular(enum mode mode, int window){
+	struct bignum a, b, m, res;
+	struct barrett br;
+
+	bn_init(&a);
+	bn_init(&b);
+	bn_init(&m);
+	bn_init(&res);
+
+	readNumber(&a, mode == MODE_MODEXP ? "base" : "first factor");
+	readNumber(&b, mode == MODE_MODEXP ? "exponent" : "second factor");
+	readNumber(&m, "modulus");
+
+	if(barrett_init(&br, &m) == -1){
+		err_msg("The modulus must not be zero!");
+	}
+
+	if(mode == MODE_MODMUL){
+		bn_divmod(NULL, &a, &a, &m);
+		bn_divmod(NULL, &b, &b, &m);
+		bn_modmul(&res, &a, &b, &br);
+	} else {
+		bn_modexp(&res, &a, &b, &br, window);
+	}
+
+	char *out = bn_to_hex(&res);
+	fprintf(stdout,"%s\n",out);
+	free(out);
+
+	barrett_free(&br);
+	bn_free(&a);
+	bn_free(&b);
+	bn_free(&m);
+	bn_free(&res);
+}
+
+/**
+ * Distributed multiplication.
+ * @brief Reads two numbers like the plain mode and lets intmul-worker daemons compute the
+ * sub-products of the top depth levels of the recursion tree.
+ *
+ * @details Every level splits both numbers into a high and a low half, so depth levels give
+ * 4^depth sub-products of numbers with 1/2^depth of the digits. The numbers are padded with
+ * leading zeros until they can be split that often. The sub-products are handed out to the
+ * workers, one task per worker at a time, and are added back together with the shift they have in
+ * the formula. If a worker cannot be reached or closes the connection without an answer it is
+ * taken out of the list and its task is given to another worker. A task that is not answered in
+ * time is queued again, the worker keeps getting tasks, but free workers that timed out less often
+ * are preferred.
+ *
+ * @param workers comma separated list of worker addresses
+ * @param depth number of recursion levels to distribute
+ * @param timeout time limit of a task in milliseconds, 0 scales it to the length of the factors
+ *
+ */
+
+static void distributed(char *workers, int depth, long long timeout){
+	struct bignum check;
+	char *numa = NULL;
+	char *numb = NULL;
+	size_t cap = 0;
+	ssize_t lena, lenb;
+
+	signal(SIGPIPE, SIG_IGN);
+
+	lena = getline(&numa, &cap, stdin);
+	cap = 0;
+	lenb = getline(&numb, &cap, stdin);
+	while(lena > 0 && (numa[lena-1] == '\n' || numa[lena-1] == '\r')){
+		numa[--lena] = '\0';
+	}
+	while(lenb > 0 && (numb[lenb-1] == '\n' || numb[lenb-1] == '\r')){
+		numb[--lenb] = '\0';
+	}
+	if(lena <= 0 || lenb <= 0){
+		err_msg("Missing number!");
+	}
+	if(lena != lenb){
+		err_msg("The numbers do not have the exact same length!");
+	}
+	bn_init(&check);
+	if(bn_from_hex(&check, numa, lena) == -1 || bn_from_hex(&check, numb, lenb) == -1){
+		err_msg("Not a valid number!");
+	}
+	bn_free(&check);
+
+	/*Workers*/
+	int nremote = 0;
+	struct remote *remotes = NULL;
+	char *save = NULL;
+
+	for(char *tok = strtok_r(workers, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save)){
+		remotes = realloc(remotes, (nremote+1)*sizeof(struct remote));
+		if(remotes == NULL){
+			err_msg("malloc");
+		}
+		memset(&remotes[nremote], 0, sizeof(struct remote));
+		remotes[nremote].addr = tok;
+		remotes[nremote].fd = -1;
+		nremote++;
+	}
+	if(nremote == 0){
+		usage();
+	}
+
+	/*Split into 4^depth tasks*/
+	size_t parts = (size_t)1 << depth;
+	size_t len = ((lena+parts-1)/parts)*parts;
+	size_t chunk = len/parts;
+
+	if(timeout == 0){
+		timeout = TASK_TIMEOUT_MS + (long long)((double)chunk*chunk/TASK_SQUARE_DIGITS);
+	}
+	char *pa = malloc(len+1);
+	char *pb = malloc(len+1);
+	int ntasks = parts*parts;
+	struct task *tasks = calloc(ntasks, sizeof(struct task));
+
+	if(pa == NULL || pb == NULL || tasks == NULL){
+		err_msg("malloc");
+	}
+	memset(pa, '0', len-lena);
+	strcpy(pa+len-lena, numa);
+	memset(pb, '0', len-lenb);
+	strcpy(pb+len-lenb, numb);
+
+	for(size_t i = 0; i < parts; i++){
+		for(size_t j = 0; j < parts; j++){
+			struct task *t = &tasks[i*parts+j];
+
+			t->numa = strndup(pa+i*chunk, chunk);
+			t->numb = strndup(pb+j*chunk, chunk);
+			if(t->numa == NULL || t->numb == NULL){
+				err_msg("malloc");
+			}
+			t->shift = ((parts-1-i)+(parts-1-j))*chunk;
+		}
+	}
+
+	/*Queue of pending tasks, failed tasks are appended again.*/
+	int *queue = malloc(ntasks*sizeof(int));
+	int head = 0;
+	int pending = ntasks;
+	int done = 0;
+	int alive = nremote;
+	struct pollfd *pfds = malloc(nremote*sizeof(struct pollfd));
+	int *pidx = malloc(nremote*sizeof(int));
+
+	if(queue == NULL || pfds == NULL || pidx == NULL){
+		err_msg("malloc");
+	}
+	for(int t = 0; t < ntasks; t++){
+		queue[t] = t;
+	}
+
+	while(done < ntasks){
+		/*Free workers that timed out least often get the tasks first.*/
+		while(pending > 0){
+			int r = -1;
+
+			for(int i = 0; i < nremote; i++){
+				if(!remotes[i].dead && remotes[i].fd == -1 &&
+					(r == -1 || remotes[i].timeouts < remotes[r].timeouts)){
+					r = i;
+				}
+			}
+			if(r == -1){
+				break;
+			}
+			int t = queue[head];
+			head = (head+1) % ntasks;
+			pending--;
+
+			if(dispatch(&remotes[r], tasks, t, timeout) == -1){
+				fprintf(stderr,"%s: worker %s is not reachable, retrying its task elsewhere\n",
+					prog_name,remotes[r].addr);
+				remotes[r].dead = 1;
+				alive--;
+				requeue(tasks, queue, ntasks, head, &pending, t);
+			}
+		}
+		if(alive == 0){
+			err_msg("All workers failed!");
+		}
+
+		int npfd = 0;
+		long long now = now_ms();
+		long long wait = timeout;
+
+		for(int r = 0; r < nremote; r++){
+			if(remotes[r].fd != -1){
+				pfds[npfd].fd = remotes[r].fd;
+				pfds[npfd].events = POLLIN;
+				pidx[npfd] = r;
+				npfd++;
+				if(remotes[r].deadline - now < wait){
+					wait = remotes[r].deadline - now;
+				}
+			}
+		}
+		if(npfd == 0){
+			continue;
+		}
+		if(poll(pfds, npfd, wait > INT_MAX ? INT_MAX : wait > 0 ? (int)wait : 0) == -1){
+			if(errno == EINTR){
+				continue;
+			}
+			err_msg("poll failed!");
+		}
+
+		now = now_ms();
+		for(int p = 0; p < npfd; p++){
+			struct remote *r = &remotes[pidx[p]];
+			int t = r->task;
+
+			if(pfds[p].revents == 0){
+				if(now < r->deadline){
+					continue;
+				}
+				fprintf(stderr,"%s: worker %s did not answer in time, retrying its task\n",
+					prog_name,r->addr);
+				close(r->fd);
+				r->fd = -1;
+				r->timeouts++;
+				requeue(tasks, queue, ntasks, head, &pending, t);
+				continue;
+			}
+			int res = receive(r, tasks);
+
+			if(res == 1){
+				r->timeouts = 0;
+				done++;
+			} else if(res == -1){
+				fprintf(stderr,"%s: worker %s died, retrying its task elsewhere\n",
+					prog_name,r->addr);
+				r->dead = 1;
+				alive--;
+				requeue(tasks, queue, ntasks, head, &pending, t);
+			}
+		}
+	}
+
+	/*Put the sub-products back together.*/
+	struct bignum result, part;
+
+	bn_init(&result);
+	bn_init(&part);
+	for(int t = 0; t < ntasks; t++){
+		if(bn_from_hex(&part, tasks[t].result, strlen(tasks[t].result)) == -1){
+			err_msg("A worker sent an invalid result!");
+		}
+		bn_add_shifted(&result, &part, 4*tasks[t].shift);
+		free(tasks[t].numa);
+		free(tasks[t].numb);
+		free(tasks[t].result);
+	}
+
+	char *out = bn_to_hex(&result);
+	fprintf(stdout,"%s\n",out);
+	free(out);
+
+	bn_free(&result);
+	bn_free(&part);
+	for(int r = 0; r < nremote; r++){
+		free(remotes[r].buf);
+	}
+	free(remotes);
+	free(tasks);
+	free(queue);
+	free(pfds);
+	free(pidx);
+	free(pa);
+	free(pb);
+	free(numa);
+	free(numb);
+}
+
+/**
+ * Monotonic clock.
+ * @return milliseconds since some fixed point
+ */
+
+static long long now_ms(){
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long long)ts.tv_sec*1000 + ts.tv_nsec/1000000;
+}
+
+/**
+ * Retry a task.
+ * @brief Appends the task to the queue again, the coordinator gives up once it has failed more
+ * than TASK_RETRIES times.
+ */
+
+static void requeue(struct task *tasks, int *queue, int ntasks, int head, int *pending, int t){
+	if(++tasks[t].retries > TASK_RETRIES){
+		err_msg("A task failed too often!");
+	}
+	queue[(head+*pending) % ntasks] = t;
+	(*pending)++;
+}
+
+/**
+ * Send a task to a worker.
+ * @brief Connects to the worker and writes both factors, one per line. Writing gives up once the
+ * worker has not taken any data for timeout milliseconds, the task times out timeout milliseconds
+ * after it has been sent.
+ *
+ * @param r the worker
+ * @param tasks all tasks
+ * @param t the index of the task to send
+ * @param timeout the time limit of the task
+ *
+ * @return 0 on success, -1 if the worker could not be reached
+ */
+
+static int dispatch(struct remote *r, struct task *tasks, int t, long long timeout){
+	int fd = net_connect(r->addr, CONNECT_TIMEOUT_MS);
+	struct timeval limit = {timeout/1000, timeout%1000*1000};
+
+	if(fd == -1){
+		return -1;
+	}
+	if(setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &limit, sizeof(limit)) == -1){
+		close(fd);
+		return -1;
+	}
+	if(net_write_all(fd, tasks[t].numa, strlen(tasks[t].numa)) == -1 ||
+		net_write_all(fd, "\n", 1) == -1 ||
+		net_write_all(fd, tasks[t].numb, strlen(tasks[t].numb)) == -1 ||
+		net_write_all(fd, "\n", 1) == -1){
+		close(fd);
+		return -1;
+	}
+	shutdown(fd, SHUT_WR);
+
+	r->fd = fd;
+	r->task = t;
+	r->len = 0;
+	r->deadline = now_ms() + timeout;
+	return 0;
+}
+
+/**
+ * Read the answer of a worker.
+ * @brief Reads what is available on the connection. Once a full line is there, it is stored as
+ * the result of the task and the worker is free again.
+ *
+ * @param r the worker
+ * @param tasks all tasks
+ *
+ * @return 1 if the task is finished, 0 if more data is needed, -1 if the worker died
+ */
+
+static int receive(struct remote *r, struct task *tasks){
+	if(r->cap - r->len < 4096){
+		r->cap = r->cap*2 + 4096;
+		r->buf = realloc(r->buf, r->cap);
+		if(r->buf == NULL){
+			err_msg("malloc");
+		}
+	}
+
+	ssize_t n = read(r->fd, r->buf+r->len, r->cap-r->len-1);
+
+	if(n == -1 && errno == EINTR){
+		return 0;
+	}
+	if(n > 0){
+		r->len += n;
+		r->buf[r->len] = '\0';
+
+		char *nl = memchr(r->buf, '\n', r->len);
+		if(nl == NULL){
+			return 0;
+		}
+		*nl = '\0';
+		if(strncmp(r->buf, "ERR", 3) == 0){
+			fprintf(stderr,"%s: worker %s: %s\n",prog_name,r->addr,r->buf);
+			exit(EXIT_FAILURE);
+		}
+		tasks[r->task].result = strdup(r->buf);
+		if(tasks[r->task].result == NULL){
+			err_msg("malloc");
+		}
+		close(r->fd);
+		r->fd = -1;
+		return 1;
+	}
+
+	/*EOF or error before a full answer*/
+	close(r->fd);
+	r->fd = -1;
+	return -1;
+}
+
 /**
  * how to use the program
  * @brief Just a synopsis function.
@@ -435,7 +946,8 @@ static int child(char *numa, char *numb, char *resp){
 
 
 static void usage(){
-	printf("%s - Synopsis:\n intmul\n",prog_name);
+	printf("%s - Synopsis:\n intmul\n intmul -m\n intmul -e [-w window]\n"
+		" intmul -c worker[,worker...] [-d depth] [-t timeout]\n",prog_name);
 	exit(EXIT_FAILURE);
 }
 
@@ -0,0 +1,614 @@
+/**
+ * @file intmul_stress.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief
+ * Differential stress test for the multiplication engines of intmul. Random and adversarial
+ * operands are multiplied by every engine and cutoff setting and compared against a simple
+ * schoolbook reference on hexadecimal digits.
+ *
+ * @details The engines are the forking intmul (run as ./intmul), the in-process kernel of
+ * bignum.c with several cutoffs, Barrett multiplication and squaring by exponentiation with a
+ * modulus larger than the product, and optionally the distributed mode against running
+ * intmul-worker daemons (-c). Every mismatch is shrunk to a small reproducing case before it is
+ * reported.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "bignum.h"
+
+#define MAX_LEN 700
+
+enum kind {ENGINE_FORK, ENGINE_KERNEL, ENGINE_MODMUL, ENGINE_MODEXP, ENGINE_REMOTE};
+
+/*One engine with one setting.*/
+struct engine{
+	enum kind kind;
+	size_t param;
+	char name[32];
+};
+
+static void usage();
+static void err_msg(char *msg);
+static char *reference(const char *a, const char *b);
+static char *runEngine(const struct engine *e, const char *a, const char *b);
+static char *runProcess(char *const argv[], const char *a, const char *b);
+static int fails(const struct engine *e, const char *a, const char *b);
+static void minimize(const struct engine *e, char *a, char *b);
+static void generate(char *buf, size_t len);
+static size_t pickLength();
+static uint64_t next();
+static unsigned int digit(char c);
+static int applicable(const struct engine *e, size_t lena, size_t lenb);
+
+char *prog_name;
+static char *intmul_path = "./intmul";
+static char *workers = NULL;
+static size_t fork_max = 16;
+static uint64_t rng_state;
+
+static const size_t cutoffs[] = {2, 3, 4, 5, 8, 16, 32, 64};
+
+/**
+ * Program entry point.
+ * @brief Parses the options, builds the list of engines and runs the given number of rounds.
+ *
+ * @details Every round picks two operands and checks every applicable engine. The exit status
+ * is EXIT_FAILURE if any engine disagreed with the reference.
+ *
+ * @param argc The argument counter.
+ * @param argv The argument vector.
+ *
+ */
+
+int main(int argc, char *argv[]){
+	prog_name = argv[0];
+
+	long rounds = 200;
+	uint64_t seed = 1;
+	int c;
+
+	while((c = getopt(argc, argv, "n:s:p:c:F:")) != -1){
+		switch(c){
+			case 'n':
+				rounds = strtol(optarg, NULL, 10);
+				break;
+			case 's':
+				seed = strtoull(optarg, NULL, 10);
+				break;
+			case 'p':
+				intmul_path = optarg;
+				break;
+			case 'c':
+				workers = optarg;
+				break;
+			case 'F':
+				fork_max = strtoul(optarg, NULL, 10);
+				break;
+			default:
+				usage();
+		}
+	}
+	if(optind < argc || rounds <= 0){
+		usage();
+	}
+	rng_state = seed*0x9E3779B97F4A7C15ull + 1;
+
+	struct engine engines[32];
+	int nengines = 0;
+
+	engines[nengines].kind = ENGINE_FORK;
+	engines[nengines].param = 0;
+	strcpy(engines[nengines++].name, "fork");
+	for(size_t i = 0; i < sizeof(cutoffs)/sizeof(cutoffs[0]); i++){
+		engines[nengines].kind = ENGINE_KERNEL;
+		engines[nengines].param = cutoffs[i];
+		sprintf(engines[nengines++].name, "kernel/cutoff=%zu", cutoffs[i]);
+	}
+	engines[nengines].kind = ENGINE_MODMUL;
+	engines[nengines].param = 0;
+	strcpy(engines[nengines++].name, "barrett-modmul");
+	engines[nengines].kind = ENGINE_MODEXP;
+	engines[nengines].param = 0;
+	strcpy(engines[nengines++].name, "barrett-modexp");
+	if(workers != NULL){
+		for(size_t d = 1; d <= 3; d++){
+			engines[nengines].kind = ENGINE_REMOTE;
+			engines[nengines].param = d;
+			sprintf(engines[nengines++].name, "remote/depth=%zu", d);
+		}
+	}
+
+	char *a = malloc(MAX_LEN+1);
+	char *b = malloc(MAX_LEN+1);
+	long checks = 0;
+	int mismatches = 0;
+
+	if(a == NULL || b == NULL){
+		err_msg("malloc");
+	}
+
+	for(long r = 0; r < rounds; r++){
+		size_t lena = pickLength();
+		size_t lenb = (next() % 4 == 0) ? pickLength() : lena;
+
+		generate(a, lena);
+		generate(b, lenb);
+
+		for(int e = 0; e < nengines; e++){
+			if(!applicable(&engines[e], lena, lenb)){
+				continue;
+			}
+			checks++;
+			if(fails(&engines[e], a, b)){
+				mismatches++;
+				char *ma = strdup(a);
+				char *mb = strdup(b);
+
+				if(ma == NULL || mb == NULL){
+					err_msg("malloc");
+				}
+				minimize(&engines[e], ma, mb);
+
+				char *expected = reference(ma, engines[e].kind == ENGINE_MODEXP ? ma : mb);
+				char *got = runEngine(&engines[e], ma, mb);
+				printf("MISMATCH %s (seed %llu, round %ld)\n  a        = %s\n  b        = %s\n"
+					"  expected = %s\n  got      = %s\n", engines[e].name,
+					(unsigned long long)seed, r, ma, mb, expected, got == NULL ? "(error)" : got);
+				free(expected);
+				free(got);
+				free(ma);
+				free(mb);
+			}
+		}
+	}
+
+	printf("%ld checks, %d mismatches\n", checks, mismatches);
+	free(a);
+	free(b);
+	exit(mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/**
+ * Engine preconditions.
+ * @brief The forking intmul only takes numbers of the same length that is a power of 2 and gets
+ * very slow for long numbers, the distributed mode needs the same length.
+ *
+ * @return 1 if the engine can multiply numbers of these lengths
+ */
+
+static int applicable(const struct engine *e, size_t lena, size_t lenb){
+	switch(e->kind){
+		case ENGINE_FORK:
+			return lena == lenb && lena <= fork_max && (lena & (lena-1)) == 0;
+		case ENGINE_REMOTE:
+			return lena == lenb;
+		default:
+			return 1;
+	}
+}
+
+/**
+ * Check one engine.
+ * @brief Compares the output of an engine with the reference, ignoring leading zeros and case.
+ *
+ * @return 1 if the engine failed or disagreed
+ */
+
+static int fails(const struct engine *e, const char *a, const char *b){
+	char *got = runEngine(e, a, b);
+	char *expected = reference(a, e->kind == ENGINE_MODEXP ? a : b);
+	int res = 1;
+
+	if(got != NULL){
+		const char *g = got;
+		while(*g == '0' && *(g+1) != '\0'){
+			g++;
+		}
+		res = strcasecmp(g, expected) != 0;
+	}
+	free(got);
+	free(expected);
+	return res;
+}
+
+/**
+ * Run an engine.
+ * @brief Multiplies a and b with the given engine. ENGINE_MODEXP squares a.
+ *
+ * @return the malloc'ed result without trailing newline, or NULL if the engine failed
+ */
+
+static char *runEngine(const struct engine *e, const char *a, const char *b){
+	struct bignum x, y, res;
+	char *out = NULL;
+
+	if(e->kind == ENGINE_FORK){
+		char *argv[] = {intmul_path, NULL};
+		return runProcess(argv, a, b);
+	}
+	if(e->kind == ENGINE_REMOTE){
+		char depth[16];
+		sprintf(depth, "%zu", e->param);
+		char *argv[] = {intmul_path, "-c", workers, "-d", depth, NULL};
+		return runProcess(argv, a, b);
+	}
+
+	bn_init(&x);
+	bn_init(&y);
+	bn_init(&res);
+	bn_from_hex(&x, a, strlen(a));
+	bn_from_hex(&y, b, strlen(b));
+
+	if(e->kind == ENGINE_KERNEL){
+		size_t saved = bn_mul_cutoff;
+		bn_mul_cutoff = e->param;
+		bn_mul(&res, &x, &y);
+		bn_mul_cutoff = saved;
+	} else {
+		/*Modulus 16^(la+lb+1)+1 is larger than every product, so nothing is reduced away.*/
+		size_t mlen = strlen(a)+strlen(e->kind == ENGINE_MODEXP ? a : b)+2;
+		char *mhex = malloc(mlen+1);
+		struct bignum m;
+		struct barrett br;
+
+		if(mhex == NULL){
+			err_msg("malloc");
+		}
+		memset(mhex, '0', mlen);
+		mhex[0] = '1';
+		mhex[mlen-1] = '1';
+		mhex[mlen] = '\0';
+		bn_init(&m);
+		bn_from_hex(&m, mhex, mlen);
+		barrett_init(&br, &m);
+
+		if(e->kind == ENGINE_MODMUL){
+			bn_modmul(&res, &x, &y, &br);
+		} else {
+			struct bignum two;
+			bn_init(&two);
+			bn_set_u32(&two, 2);
+			bn_modexp(&res, &x, &two, &br, 0);
+			bn_free(&two);
+		}
+		barrett_free(&br);
+		bn_free(&m);
+		free(mhex);
+	}
+	out = bn_to_hex(&res);
+
+	bn_free(&x);
+	bn_free(&y);
+	bn_free(&res);
+	return out;
+}
+
+/**
+ * Run intmul as a process.
+ * @brief Writes both numbers to stdin of the program and reads the first line of its output.
+ *
+ * @return the malloc'ed line, or NULL if the program did not exit successfully
+ */
+
+static char *runProcess(char *const argv[], const char *a, const char *b){
+	int in[2];
+	int out[2];
+
+	if(pipe(in) == -1 || pipe(out) == -1){
+		err_msg("Could not create pipes!");
+	}
+
+	pid_t pid = fork();
+	if(pid == -1){
+		err_msg("Cannot fork!");
+	}
+	if(pid == 0){
+		dup2(in[0], STDIN_FILENO);
+		dup2(out[1], STDOUT_FILENO);
+		close(in[0]);
+		close(in[1]);
+		close(out[0]);
+		close(out[1]);
+		execv(argv[0], argv);
+		exit(127);
+	}
+	close(in[0]);
+	close(out[1]);
+
+	FILE *w = fdopen(in[1], "w");
+	FILE *r = fdopen(out[0], "r");
+	fprintf(w, "%s\n%s\n", a, b);
+	fclose(w);
+
+	char *line = NULL;
+	size_t cap = 0;
+	ssize_t len = getline(&line, &cap, r);
+	fclose(r);
+
+	int status;
+	waitpid(pid, &status, 0);
+	if(len <= 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS){
+		free(line);
+		return NULL;
+	}
+	while(len > 0 && (line[len-1] == '\n' || line[len-1] == '\r')){
+		line[--len] = '\0';
+	}
+	return line;
+}
+
+/**
+ * Reference multiplication.
+ * @brief Schoolbook multiplication on single hexadecimal digits. Slow, but simple enough to trust.
+ *
+ * @return the malloc'ed product in upper case without leading zeros
+ */
+
+static char *reference(const char *a, const char *b){
+	size_t la = strlen(a);
+	size_t lb = strlen(b);
+	unsigned int *acc = calloc(la+lb, sizeof(unsigned int));
+	char *res = malloc(la+lb+1);
+
+	if(acc == NULL || res == NULL){
+		err_msg("malloc");
+	}
+
+	for(size_t i = 0; i < la; i++){
+		unsigned int da = digit(a[la-1-i]);
+		for(size_t j = 0; j < lb; j++){
+			acc[i+j] += da * digit(b[lb-1-j]);
+		}
+	}
+	for(size_t k = 0; k+1 < la+lb; k++){
+		acc[k+1] += acc[k]/16;
+		acc[k] %= 16;
+	}
+
+	size_t top = la+lb;
+	while(top > 1 && acc[top-1] == 0){
+		top--;
+	}
+	for(size_t k = 0; k < top; k++){
+		res[k] = "0123456789ABCDEF"[acc[top-1-k]];
+	}
+	res[top] = '\0';
+	free(acc);
+	return res;
+}
+
+/**
+ * Value of a digit.
+ * @return the value of the hexadecimal digit c
+ */
+
+static unsigned int digit(char c){
+	if(c >= '0' && c <= '9'){
+		return c - '0';
+	} else if(c >= 'a' && c <= 'f'){
+		return c - 'a' + 10;
+	}
+	return c - 'A' + 10;
+}
+
+/**
+ * Shrink a failing case.
+ * @brief Repeatedly tries smaller variants of a and b and keeps every variant that still fails,
+ * until none of them does.
+ *
+ * @details The variants are: both halves (keeps the lengths equal and a power of 2), dropping the
+ * leading or the last digit of one operand where the engine allows different lengths, and
+ * replacing single digits by 0 or 1.
+ *
+ * @param e the failing engine
+ * @param a first operand, shrunk in place
+ * @param b second operand, shrunk in place
+ */
+
+static void minimize(const struct engine *e, char *a, char *b){
+	char *ta = malloc(MAX_LEN+1);
+	char *tb = malloc(MAX_LEN+1);
+	int changed = 1;
+
+	if(ta == NULL || tb == NULL){
+		err_msg("malloc");
+	}
+
+	while(changed){
+		changed = 0;
+		size_t la = strlen(a);
+		size_t lb = strlen(b);
+
+		/*Halves*/
+		if(la == lb && la > 1 && la % 2 == 0){
+			for(int half = 0; half < 2 && !changed; half++){
+				strncpy(ta, a+half*la/2, la/2);
+				ta[la/2] = '\0';
+				strncpy(tb, b+half*lb/2, lb/2);
+				tb[lb/2] = '\0';
+				if(fails(e, ta, tb)){
+					strcpy(a, ta);
+					strcpy(b, tb);
+					changed = 1;
+				}
+			}
+			if(changed){
+				continue;
+			}
+		}
+
+		/*Shorter operands*/
+		if(applicable(e, la-1, lb) && la > 1 && fails(e, a+1, b)){
+			memmove(a, a+1, la);
+			changed = 1;
+			continue;
+		}
+		if(applicable(e, la, lb-1) && lb > 1 && fails(e, a, b+1)){
+			memmove(b, b+1, lb);
+			changed = 1;
+			continue;
+		}
+		if(applicable(e, la-1, lb) && la > 1){
+			strncpy(ta, a, la-1);
+			ta[la-1] = '\0';
+			if(fails(e, ta, b)){
+				a[la-1] = '\0';
+				changed = 1;
+				continue;
+			}
+		}
+		if(applicable(e, la, lb-1) && lb > 1){
+			strncpy(tb, b, lb-1);
+			tb[lb-1] = '\0';
+			if(fails(e, a, tb)){
+				b[lb-1] = '\0';
+				changed = 1;
+				continue;
+			}
+		}
+
+		/*Simpler digits*/
+		for(int op = 0; op < 2 && !changed; op++){
+			char *num = op == 0 ? a : b;
+			size_t len = strlen(num);
+
+			for(size_t i = 0; i < len && !changed; i++){
+				const char *smaller = "01";
+				for(int s = 0; s < 2 && !changed; s++){
+					char old = num[i];
+					if(digit(old) <= (unsigned int)s){
+						continue;
+					}
+					num[i] = smaller[s];
+					if(fails(e, a, b)){
+						changed = 1;
+					} else {
+						num[i] = old;
+					}
+				}
+			}
+		}
+	}
+	free(ta);
+	free(tb);
+}
+
+/**
+ * Pick an operand length.
+ * @brief Mostly lengths around the thresholds: powers of 2 for the forking engine and the digit
+ * counts where the kernel switches between schoolbook and recursion for every cutoff.
+ *
+ */
+
+static size_t pickLength(){
+	size_t len;
+
+	switch(next() % 4){
+		case 0:
+			len = (size_t)1 << (next() % 5);
+			break;
+		case 1:{
+			size_t c = cutoffs[next() % (sizeof(cutoffs)/sizeof(cutoffs[0]))];
+			size_t mult = 1 + next() % 4;
+			len = 8*c*mult + (next() % 3) - 1;
+			break;
+		}
+		case 2:
+			len = 1 + next() % 64;
+			break;
+		default:
+			len = 1 + next() % MAX_LEN;
+			break;
+	}
+	if(len == 0){
+		len = 1;
+	}
+	return len > MAX_LEN ? MAX_LEN : len;
+}
+
+/**
+ * Generate an operand.
+ * @brief Writes len hexadecimal digits into buf: random, all F's, alternating patterns, sparse,
+ * with leading zeros or a single top digit.
+ *
+ */
+
+static void generate(char *buf, size_t len){
+	const char *hex = "0123456789ABCDEF";
+	int pattern = next() % 7;
+
+	for(size_t i = 0; i < len; i++){
+		switch(pattern){
+			case 0:
+				buf[i] = 'F';
+				break;
+			case 1:
+				buf[i] = (i % 2) ? '5' : 'A';
+				break;
+			case 2:
+				buf[i] = ((i/8) % 2) ? '0' : 'F';
+				break;
+			case 3:
+				buf[i] = (next() % 16 == 0) ? hex[next() % 16] : '0';
+				break;
+			case 4:
+				buf[i] = (i < len/2) ? '0' : hex[next() % 16];
+				break;
+			case 5:
+				buf[i] = (i == 0) ? '8' : '0';
+				break;
+			default:
+				buf[i] = hex[next() % 16];
+				break;
+		}
+	}
+	buf[len] = '\0';
+}
+
+/**
+ * Random numbers.
+ * @brief splitmix64, so that a seed reproduces a run on every machine.
+ *
+ */
+
+static uint64_t next(){
+	uint64_t z = (rng_state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+/**
+ * how to use the stress test
+ * @brief Just a synopsis function.
+ *
+ */
+
+static void usage(){
+	printf("%s - Synopsis:\n intmul-stress [-n rounds] [-s seed] [-p intmul] [-F maxforklen]"
+		" [-c worker[,worker...]]\n",prog_name);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * the error function
+ * @brief gets a string and pastes it to stderr, then exits
+ *
+ * @param msg the error message
+ *
+ */
+
+static void err_msg(char *msg){
+	fprintf(stderr,"%s: %s\n",prog_name,msg);
+	exit(EXIT_FAILURE);
+}
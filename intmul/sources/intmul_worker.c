@@ -0,0 +1,201 @@
+/**
+ * @file intmul_worker.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief
+ * Worker daemon for distributed multiplication. It accepts sub-products from an intmul
+ * coordinator (intmul -c) over TCP or a Unix domain socket and answers with their product.
+ *
+ * @details The protocol is the one child() speaks over its pipes: the two factors as hexadecimal
+ * numbers, one per line, and the product as one line back. Invalid input is answered with a line
+ * starting with "ERR". Every connection is served by its own child process, so a crashing task
+ * never takes the daemon down.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include "bignum.h"
+#include "net.h"
+
+static void usage();
+static void err_msg(char *msg);
+static void serve(int fd);
+static int readNumber(FILE *in, struct bignum *num);
+static void signal_handler(int signal);
+
+char *prog_name;
+static const char *listen_addr;
+static volatile sig_atomic_t quit = 0;
+
+/**
+ * Program entry point.
+ * @brief The worker is started with the address it listens on, e.g. 127.0.0.1:7001 or
+ * unix:/tmp/intmul.sock.
+ *
+ * @param argc The argument counter.
+ * @param argv The argument vector.
+ *
+ */
+
+int main(int argc, char *argv[]){
+	prog_name = argv[0];
+
+	if(argc != 2){
+		usage();
+	}
+	listen_addr = argv[1];
+
+	struct sigaction sa;
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = signal_handler;
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+
+	/*Children are not waited for, a dead coordinator must not kill us.*/
+	signal(SIGCHLD, SIG_IGN);
+	signal(SIGPIPE, SIG_IGN);
+
+	int lfd = net_listen(listen_addr);
+	if(lfd == -1){
+		err_msg("Could not listen on the given address!");
+	}
+
+	while(!quit){
+		int cfd = accept(lfd, NULL, NULL);
+
+		if(cfd == -1){
+			if(errno == EINTR || errno == ECONNABORTED){
+				continue;
+			}
+			close(lfd);
+			err_msg("accept failed!");
+		}
+
+		switch(fork()){
+			case -1:
+				close(cfd);
+				break;
+			case 0:
+				close(lfd);
+				serve(cfd);
+				exit(EXIT_SUCCESS);
+			default:
+				close(cfd);
+				break;
+		}
+	}
+
+	close(lfd);
+	if(strncmp(listen_addr, "unix:", 5) == 0){
+		unlink(listen_addr+5);
+	}
+	exit(EXIT_SUCCESS);
+}
+
+/**
+ * Serve one sub-product.
+ * @brief Reads the two factors from the connection, multiplies them and writes the result back.
+ *
+ * @param fd the connected socket
+ *
+ */
+
+static void serve(int fd){
+	FILE *in = fdopen(fd, "r");
+	struct bignum a, b, res;
+
+	if(in == NULL){
+		close(fd);
+		return;
+	}
+
+	bn_init(&a);
+	bn_init(&b);
+	bn_init(&res);
+
+	if(readNumber(in, &a) == -1 || readNumber(in, &b) == -1){
+		const char *msg = "ERR invalid number\n";
+		net_write_all(fd, msg, strlen(msg));
+	} else {
+		bn_mul(&res, &a, &b);
+
+		char *out = bn_to_hex(&res);
+		size_t len = strlen(out);
+
+		out[len] = '\n';
+		net_write_all(fd, out, len+1);
+		free(out);
+	}
+
+	bn_free(&a);
+	bn_free(&b);
+	bn_free(&res);
+	fclose(in);
+}
+
+/**
+ * Read one factor.
+ * @brief Reads a line from the connection and parses it as hexadecimal number.
+ *
+ * @return 0 on success, -1 on EOF or invalid input
+ */
+
+static int readNumber(FILE *in, struct bignum *num){
+	char *line = NULL;
+	size_t cap = 0;
+	ssize_t len = getline(&line, &cap, in);
+	int res;
+
+	if(len <= 0){
+		free(line);
+		return -1;
+	}
+	while(len > 0 && (line[len-1] == '\n' || line[len-1] == '\r')){
+		len--;
+	}
+	res = bn_from_hex(num, line, len);
+	free(line);
+	return res;
+}
+
+/**
+ * Handles interrupts.
+ * @brief Stops the accept loop, main() then removes a Unix socket file.
+ *
+ */
+
+static void signal_handler(int signal){
+	quit = 1;
+}
+
+/**
+ * how to use the worker
+ * @brief Just a synopsis function.
+ *
+ */
+
+static void usage(){
+	printf("%s - Synopsis:\n intmul-worker host:port\n intmul-worker unix:/path\n",prog_name);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * the error function
+ * @brief gets a string and pastes it to stderr, then exits
+ *
+ * @param msg the error message
+ *
+ */
+
+static void err_msg(char *msg){
+	fprintf(stderr,"%s: %s\n",prog_name,msg);
+	exit(EXIT_FAILURE);
+}
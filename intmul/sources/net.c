@@ -0,0 +1,249 @@
+/**
+ * @file net.c
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Socket helpers shared by the intmul coordinator and intmul-worker.
+ *
+ * @details All functions return -1 and leave errno set on failure, the callers decide how to
+ * report it.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "net.h"
+
+#define UNIX_PREFIX "unix:"
+
+/**
+ * Fill in a Unix socket address.
+ * @brief Copies the path behind "unix:" into sun.
+ *
+ * @return 0 on success, -1 if the path is too long
+ */
+
+static int unix_addr(const char *addr, struct sockaddr_un *sun){
+	const char *path = addr+strlen(UNIX_PREFIX);
+
+	memset(sun, 0, sizeof(*sun));
+	sun->sun_family = AF_UNIX;
+	if(strlen(path) == 0 || strlen(path) >= sizeof(sun->sun_path)){
+		errno = ENAMETOOLONG;
+		return -1;
+	}
+	strcpy(sun->sun_path, path);
+	return 0;
+}
+
+/**
+ * Resolve a TCP address.
+ * @brief Splits "host:port" and looks it up. An empty host means all interfaces (listen) or
+ * localhost (connect).
+ *
+ * @return the address list (free with freeaddrinfo) or NULL
+ */
+
+static struct addrinfo *tcp_addr(const char *addr, int passive){
+	char *copy = strdup(addr);
+	char *colon;
+	struct addrinfo hints;
+	struct addrinfo *res = NULL;
+
+	if(copy == NULL){
+		return NULL;
+	}
+	colon = strrchr(copy, ':');
+	if(colon == NULL){
+		free(copy);
+		errno = EINVAL;
+		return NULL;
+	}
+	*colon = '\0';
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = passive ? AI_PASSIVE : 0;
+
+	if(getaddrinfo(strlen(copy) > 0 ? copy : NULL, colon+1, &hints, &res) != 0){
+		res = NULL;
+		errno = EINVAL;
+	}
+	free(copy);
+	return res;
+}
+
+/**
+ * Connect a socket within a time limit.
+ * @brief Connects without blocking and waits for the result at most timeout milliseconds, so a
+ * host that drops packets does not hold the caller. The socket is blocking again afterwards.
+ *
+ * @return 0 on success, -1 on failure (errno ETIMEDOUT if the time ran out)
+ */
+
+static int connect_within(int fd, const struct sockaddr *sa, socklen_t len, int timeout){
+	int flags = fcntl(fd, F_GETFL);
+
+	if(flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1){
+		return -1;
+	}
+	if(connect(fd, sa, len) == -1){
+		struct pollfd pfd = {fd, POLLOUT, 0};
+		int err = 0;
+		socklen_t errlen = sizeof(err);
+		int ready;
+
+		if(errno != EINPROGRESS && errno != EINTR){
+			return -1;
+		}
+		while((ready = poll(&pfd, 1, timeout)) == -1 && errno == EINTR){
+		}
+		if(ready == -1){
+			return -1;
+		}
+		if(ready == 0){
+			errno = ETIMEDOUT;
+			return -1;
+		}
+		if(getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &errlen) == -1){
+			return -1;
+		}
+		if(err != 0){
+			errno = err;
+			return -1;
+		}
+	}
+	return fcntl(fd, F_SETFL, flags);
+}
+
+/**
+ * Listen on an address.
+ * @brief Creates a listening socket. A stale Unix socket file is removed first.
+ *
+ * @param addr "host:port" or "unix:/path"
+ *
+ * @return the socket or -1
+ */
+
+int net_listen(const char *addr){
+	int fd;
+
+	if(strncmp(addr, UNIX_PREFIX, strlen(UNIX_PREFIX)) == 0){
+		struct sockaddr_un sun;
+
+		if(unix_addr(addr, &sun) == -1){
+			return -1;
+		}
+		unlink(sun.sun_path);
+		if((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1){
+			return -1;
+		}
+		if(bind(fd, (struct sockaddr *)&sun, sizeof(sun)) == -1 || listen(fd, 64) == -1){
+			close(fd);
+			return -1;
+		}
+		return fd;
+	}
+
+	struct addrinfo *res = tcp_addr(addr, 1);
+	int one = 1;
+
+	if(res == NULL){
+		return -1;
+	}
+	fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+	if(fd == -1){
+		freeaddrinfo(res);
+		return -1;
+	}
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+	if(bind(fd, res->ai_addr, res->ai_addrlen) == -1 || listen(fd, 64) == -1){
+		close(fd);
+		freeaddrinfo(res);
+		return -1;
+	}
+	freeaddrinfo(res);
+	return fd;
+}
+
+/**
+ * Connect to an address.
+ * @brief Opens a stream connection to a worker.
+ *
+ * @param addr "host:port" or "unix:/path"
+ * @param timeout milliseconds each address may take to connect
+ *
+ * @return the socket or -1
+ */
+
+int net_connect(const char *addr, int timeout){
+	int fd;
+
+	if(strncmp(addr, UNIX_PREFIX, strlen(UNIX_PREFIX)) == 0){
+		struct sockaddr_un sun;
+
+		if(unix_addr(addr, &sun) == -1){
+			return -1;
+		}
+		if((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1){
+			return -1;
+		}
+		if(connect_within(fd, (struct sockaddr *)&sun, sizeof(sun), timeout) == -1){
+			close(fd);
+			return -1;
+		}
+		return fd;
+	}
+
+	struct addrinfo *res = tcp_addr(addr, 0);
+	struct addrinfo *cur;
+
+	if(res == NULL){
+		return -1;
+	}
+	for(cur = res; cur != NULL; cur = cur->ai_next){
+		fd = socket(cur->ai_family, cur->ai_socktype, cur->ai_protocol);
+		if(fd == -1){
+			continue;
+		}
+		if(connect_within(fd, cur->ai_addr, cur->ai_addrlen, timeout) == 0){
+			freeaddrinfo(res);
+			return fd;
+		}
+		close(fd);
+	}
+	freeaddrinfo(res);
+	return -1;
+}
+
+/**
+ * Write a whole buffer.
+ * @brief Repeats write() until everything is written.
+ *
+ * @return 0 on success, -1 on error
+ */
+
+int net_write_all(int fd, const char *buf, size_t len){
+	while(len > 0){
+		ssize_t n = write(fd, buf, len);
+
+		if(n == -1){
+			if(errno == EINTR){
+				continue;
+			}
+			return -1;
+		}
+		buf += n;
+		len -= n;
+	}
+	return 0;
+}
@@ -0,0 +1,23 @@
+/**
+ * @file net.h
+ * @author Philipp Geisler <philipp.geisler@student.tuwien.ac.at>
+ * @date 19.10.2026
+ *
+ * @brief Socket helpers shared by the intmul coordinator and intmul-worker.
+ *
+ * @details Addresses are written as "host:port" for TCP or "unix:/path" for Unix domain sockets.
+ * The protocol on top is the one child() uses on its pipes: two hexadecimal numbers, one per
+ * line, answered by their product on one line.
+ *
+ */
+
+#ifndef NET_H
+#define NET_H
+
+#include <stddef.h>
+
+int net_listen(const char *addr);
+int net_connect(const char *addr, int timeout);
+int net_write_all(int fd, const char *buf, size_t len);
+
+#endif